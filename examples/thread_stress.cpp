@@ -0,0 +1,142 @@
+// Hammers one shared DomeClient from many threads while other threads change its
+// headers, warm its pool and swap WebSocket callbacks. Build with
+// -DDOME_SANITIZE_THREAD=ON and run it to check the thread-safe paths under TSAN.
+//
+//   ./thread_stress [base_url] [threads] [seconds]
+//
+// Point base_url at a reachable server (a local mock will do): only then are
+// connections kept and reused across requests. Without one the requests fail
+// fast, which still exercises the settings snapshots and error reporting.
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dome_api_sdk/client.hpp>
+#include <dome_api_sdk/dome_websocket.hpp>
+
+using Clock = std::chrono::steady_clock;
+
+int main(int argc, char* argv[]) {
+    dome::DomeSDKConfig config;
+    config.api_key = "stress-test";
+    config.base_url = argc > 1 ? argv[1] : "http://127.0.0.1:9/v1";
+    config.timeout = 5;
+    config.intern_table = std::make_shared<dome::InternTable>();
+    config.transfer_stats = std::make_shared<dome::TransferStats>();
+    const int threads = argc > 2 ? std::atoi(argv[2]) : 32;
+    const auto duration = std::chrono::seconds(argc > 3 ? std::atoi(argv[3]) : 5);
+
+    dome::DomeClient dome(config);
+    dome::HttpClient http(config.base_url, config.api_key, 5.0f);
+    dome::DomeWebSocket ws(config.api_key);
+    dome::AsyncLoop loop;
+
+    std::atomic<bool> running{true};
+    std::atomic<long> succeeded{0};
+    std::atomic<long> failed{0};
+    std::atomic<long> async_completed{0};
+
+    auto count = [&](auto&& request) {
+        try {
+            request();
+            ++succeeded;
+        } catch (const dome::DomeAPIError&) {
+            ++failed;
+        }
+    };
+
+    std::vector<std::thread> workers;
+
+    // Blocking requests on the shared client, including per-thread prepared requests
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            auto prepared = dome.polymarket.markets.prepare_market_price();
+            dome::GetMarketPriceParams price_params{std::to_string(1000 + t), std::nullopt};
+            dome::GetOrdersParams orders_params;
+            orders_params.limit = 10;
+            for (int i = 0; running; ++i) {
+                switch (i % 4) {
+                    case 0: count([&] { dome.polymarket.markets.get_market_price(price_params); }); break;
+                    case 1: count([&] { prepared.get(price_params); }); break;
+                    case 2: count([&] { dome.polymarket.orders.get_orders(orders_params); }); break;
+                    case 3:
+                        count([&] { dome.polymarket.orders.stream_orders(orders_params, [](const dome::Order&) {}); });
+                        break;
+                }
+            }
+        });
+    }
+
+    // Async requests started from several threads, driven by one loop thread
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&, t] {
+            while (running) {
+                if (loop.pending() < 64) {
+                    dome::GetMarketPriceParams params{std::to_string(2000 + t), std::nullopt};
+                    dome.polymarket.markets.get_market_price_async(loop, params)
+                        .then([&](std::exception_ptr, dome::MarketPriceResponse) { ++async_completed; });
+                } else {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+        });
+    }
+    workers.emplace_back([&] {
+        while (running || loop.pending() > 0) {
+            loop.run_once(std::chrono::milliseconds(10));
+        }
+    });
+
+    // Raw requests on a client whose settings another thread keeps replacing
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&] {
+            while (running) {
+                count([&] { http.get("/polymarket/market-price/3000"); });
+            }
+        });
+    }
+
+    // Writers: header and encoding changes, pool warmup and WebSocket handler swaps
+    workers.emplace_back([&] {
+        for (int i = 0; running; ++i) {
+            http.set_header("X-Stress-Iteration", std::to_string(i));
+            http.set_accept_encoding(i % 2 ? std::optional<std::string>() : std::string());
+            http.set_transfer_stats(i % 3 ? config.transfer_stats : nullptr);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    workers.emplace_back([&] {
+        while (running) {
+            dome.warmup(2);
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+    });
+    workers.emplace_back([&] {
+        for (int i = 0; running; ++i) {
+            ws.set_order_event_callback([i](const dome::WebSocketOrderEvent&) { (void)i; });
+            ws.set_intern_table(i % 2 ? config.intern_table : nullptr);
+            auto subscriptions = ws.get_subscriptions();
+            (void)subscriptions;
+        }
+    });
+
+    auto start = Clock::now();
+    std::this_thread::sleep_for(duration);
+    running = false;
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::cout << "threads:          " << threads << "\n"
+              << "requests ok:      " << succeeded << "\n"
+              << "requests failed:  " << failed << "\n"
+              << "async completed:  " << async_completed << "\n"
+              << "requests/second:  " << static_cast<long>((succeeded + failed + async_completed) / seconds) << "\n"
+              << "wire bytes:       " << config.transfer_stats->wire_bytes() << "\n";
+    return 0;
+}
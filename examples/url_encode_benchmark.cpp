@@ -0,0 +1,95 @@
+// Compares the SDK's percent-encoder and query building with the previous
+// curl_easy_escape-per-parameter path. Runs offline; no API key needed.
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <string>
+#include <curl/curl.h>
+#include <dome_api_sdk/url_encode.hpp>
+
+using Clock = std::chrono::steady_clock;
+
+// Previous HttpClient::url_encode: a fresh easy handle per call
+static std::string curl_url_encode(const std::string& value) {
+    CURL* curl = curl_easy_init();
+    if (!curl) {
+        return value;
+    }
+    char* encoded = curl_easy_escape(curl, value.c_str(), static_cast<int>(value.length()));
+    std::string result(encoded);
+    curl_free(encoded);
+    curl_easy_cleanup(curl);
+    return result;
+}
+
+// Previous HttpClient::build_url
+static std::string curl_build_url(const std::string& base, const std::string& endpoint,
+                                  const std::map<std::string, std::string>& query_params) {
+    std::string url = base + endpoint;
+    if (!query_params.empty()) {
+        url += "?";
+        bool first = true;
+        for (const auto& [key, value] : query_params) {
+            if (!first) {
+                url += "&";
+            }
+            url += curl_url_encode(key) + "=" + curl_url_encode(value);
+            first = false;
+        }
+    }
+    return url;
+}
+
+template<typename F>
+static double nanoseconds_per_call(int iterations, F&& f) {
+    size_t sink = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        sink += f().size();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    if (sink == 0) {
+        std::cout << "";
+    }
+    return elapsed / iterations;
+}
+
+int main() {
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    const std::string base = "https://api.domeapi.io/v1";
+    const std::string endpoint = "/polymarket/market-price/53246717819011119677552303714112847791810741644457544333564494709938039872568";
+    const std::map<std::string, std::string> params = {
+        {"at_time", "1768027660"},
+        {"market_slug", "will-bitcoin-reach-$150k-by-december-31-2025?"},
+        {"tags", "crypto,bitcoin,price"},
+    };
+    const std::string value = "will-bitcoin-reach-$150k-by-december-31-2025? (yes/no)";
+    const int iterations = 200000;
+
+    double curl_encode = nanoseconds_per_call(iterations, [&] { return curl_url_encode(value); });
+    double sdk_encode = nanoseconds_per_call(iterations, [&] { return dome::url_encode(value); });
+
+    double curl_url = nanoseconds_per_call(iterations, [&] { return curl_build_url(base, endpoint, params); });
+    dome::QueryBuilder builder;
+    double sdk_url = nanoseconds_per_call(iterations, [&] {
+        builder.reset(base + endpoint).add_all(params);
+        return builder.str();
+    });
+
+    if (curl_build_url(base, endpoint, params) != builder.str()) {
+        std::cerr << "Mismatch:\n  " << curl_build_url(base, endpoint, params) << "\n  " << builder.str() << "\n";
+        return 1;
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "url_encode     curl: " << curl_encode << " ns   sdk: " << sdk_encode << " ns   ("
+              << curl_encode / sdk_encode << "x)\n";
+    std::cout << "build url      curl: " << curl_url << " ns   sdk: " << sdk_url << " ns   ("
+              << curl_url / sdk_url << "x)\n";
+
+    curl_global_cleanup();
+    return 0;
+}
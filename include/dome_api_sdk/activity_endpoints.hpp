@@ -12,7 +12,13 @@ public:
 
     // Get trading activity (MERGE, SPLIT, REDEEM)
     // Endpoint: /polymarket/activity
-    ActivityResponse get_activity(const GetActivityParams& params);
+    ActivityResponse get_activity(const GetActivityParams& params, const RequestConfig& request_config = {});
+    AsyncOp<ActivityResponse> get_activity_async(AsyncLoop& loop, const GetActivityParams& params,
+                                                 const RequestConfig& request_config = {});
+
+private:
+    std::map<std::string, std::string> build_query(const GetActivityParams& params);
+    static ActivityResponse parse_activity(const nlohmann::json& json, InternTable* intern_table);
 };
 
 }  // namespace dome
@@ -0,0 +1,101 @@
+#ifndef DOME_ARENA_HPP
+#define DOME_ARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "decimal.hpp"
+#include "types.hpp"
+
+namespace dome {
+
+/**
+ * Order decoded into an arena: the same fields as Order, with every string drawn
+ * from the allocator it was constructed with. taker is empty when the order has none.
+ */
+struct ArenaOrder {
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    explicit ArenaOrder(allocator_type allocator = {})
+        : token_id(allocator), token_label(allocator), side(allocator), market_slug(allocator),
+          condition_id(allocator), tx_hash(allocator), title(allocator), order_hash(allocator),
+          user(allocator), taker(allocator) {}
+    ArenaOrder(const ArenaOrder& other, allocator_type allocator)
+        : token_id(other.token_id, allocator), token_label(other.token_label, allocator),
+          side(other.side, allocator), market_slug(other.market_slug, allocator),
+          condition_id(other.condition_id, allocator), shares(other.shares),
+          shares_normalized(other.shares_normalized), price(other.price), tx_hash(other.tx_hash, allocator),
+          title(other.title, allocator), timestamp(other.timestamp), order_hash(other.order_hash, allocator),
+          user(other.user, allocator), taker(other.taker, allocator) {}
+    ArenaOrder(ArenaOrder&& other, allocator_type allocator)
+        : token_id(std::move(other.token_id), allocator), token_label(std::move(other.token_label), allocator),
+          side(std::move(other.side), allocator), market_slug(std::move(other.market_slug), allocator),
+          condition_id(std::move(other.condition_id), allocator), shares(other.shares),
+          shares_normalized(other.shares_normalized), price(other.price),
+          tx_hash(std::move(other.tx_hash), allocator), title(std::move(other.title), allocator),
+          timestamp(other.timestamp), order_hash(std::move(other.order_hash), allocator),
+          user(std::move(other.user), allocator), taker(std::move(other.taker), allocator) {}
+    ArenaOrder(const ArenaOrder&) = default;
+    ArenaOrder(ArenaOrder&&) = default;
+    ArenaOrder& operator=(const ArenaOrder&) = default;
+    ArenaOrder& operator=(ArenaOrder&&) = default;
+
+    std::pmr::string token_id;
+    std::pmr::string token_label;
+    std::pmr::string side;
+    std::pmr::string market_slug;
+    std::pmr::string condition_id;
+    int64_t shares = 0;
+    Decimal shares_normalized;
+    Decimal price;
+    std::pmr::string tx_hash;
+    std::pmr::string title;
+    int64_t timestamp = 0;
+    std::pmr::string order_hash;
+    std::pmr::string user;
+    std::pmr::string taker;
+};
+
+/**
+ * A page of orders whose record array and strings all live in one monotonic
+ * arena (std::pmr::monotonic_buffer_resource), released in one shot by clear()
+ * or the destructor. Opt-in alternative to OrdersResponse for high-volume paging:
+ * the page owns the arena's first block and clear() rewinds into it, so reusing
+ * one page for every request decodes records without heap allocations once that
+ * block holds a whole page. Only what does not fit spills over to the heap.
+ * Not thread-safe.
+ *
+ * @param initial_bytes Size of the page's own block; about 1.2 KB per order
+ */
+class OrdersArenaPage {
+    std::unique_ptr<std::byte[]> buffer_;
+    std::pmr::monotonic_buffer_resource arena_;  // declared before orders, which it outlives
+
+public:
+    explicit OrdersArenaPage(size_t initial_bytes = 1 << 20)
+        : buffer_(new std::byte[std::max<size_t>(1, initial_bytes)]),
+          arena_(buffer_.get(), std::max<size_t>(1, initial_bytes)),
+          orders(&arena_) {}
+
+    OrdersArenaPage(const OrdersArenaPage&) = delete;
+    OrdersArenaPage& operator=(const OrdersArenaPage&) = delete;
+
+    // Drop the records and rewind the arena to the start of its own block
+    void clear() {
+        std::pmr::vector<ArenaOrder>(&arena_).swap(orders);
+        pagination = Pagination{};
+        arena_.release();
+    }
+
+    std::pmr::vector<ArenaOrder> orders;
+    Pagination pagination{};
+};
+
+}  // namespace dome
+
+#endif  // DOME_ARENA_HPP
@@ -0,0 +1,260 @@
+#ifndef DOME_ASYNC_HPP
+#define DOME_ASYNC_HPP
+
+#include <exception>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define DOME_HAS_COROUTINES 1
+#else
+#define DOME_HAS_COROUTINES 0
+#endif
+
+namespace dome {
+
+// Completion of an asynchronous operation: error is null on success, otherwise
+// result is default-constructed
+template<typename T>
+using AsyncCallback = std::function<void(std::exception_ptr error, T result)>;
+
+/**
+ * A request that has not been started yet.
+ *
+ * Start it with then(callback), or co_await it from any C++20 coroutine. It is
+ * single-shot: both consume it. Completions run on the thread driving the
+ * AsyncLoop, or through the loop's executor when one is set.
+ */
+template<typename T>
+class AsyncOp {
+public:
+    using Start = std::function<void(AsyncCallback<T>)>;
+
+    explicit AsyncOp(Start start) : start_(std::move(start)) {}
+
+    // Start the operation; callback is invoked exactly once
+    void then(AsyncCallback<T> callback) && {
+        Start start = std::move(start_);
+        start(std::move(callback));
+    }
+
+    // Operation yielding f(result); exceptions thrown by f become its error
+    template<typename F>
+    auto map(F f) && -> AsyncOp<std::invoke_result_t<F, T>> {
+        using U = std::invoke_result_t<F, T>;
+        return AsyncOp<U>([start = std::move(start_), f = std::move(f)](AsyncCallback<U> done) {
+            start([f, done](std::exception_ptr error, T result) {
+                if (error) {
+                    done(error, U());
+                    return;
+                }
+                U mapped;
+                try {
+                    mapped = f(std::move(result));
+                } catch (...) {
+                    done(std::current_exception(), U());
+                    return;
+                }
+                done(nullptr, std::move(mapped));
+            });
+        });
+    }
+
+private:
+    Start start_;
+};
+
+#if DOME_HAS_COROUTINES
+
+// co_await an AsyncOp: suspends until it completes, then returns its result or rethrows
+template<typename T>
+auto operator co_await(AsyncOp<T>&& op) {
+    struct Awaiter {
+        AsyncOp<T> op;
+        std::optional<T> result;
+        std::exception_ptr error;
+
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            std::move(op).then([this, handle](std::exception_ptr e, T value) {
+                error = e;
+                if (!e) {
+                    result.emplace(std::move(value));
+                }
+                handle.resume();
+            });
+        }
+
+        T await_resume() {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            return std::move(*result);
+        }
+    };
+    return Awaiter{std::move(op), std::nullopt, nullptr};
+}
+
+/**
+ * Minimal lazy coroutine type for code without its own (asio::awaitable,
+ * cppcoro::task, ...). A Task starts when it is awaited or passed to spawn().
+ */
+template<typename T = void>
+class Task;
+
+namespace detail {
+
+// Resumes the awaiting coroutine when a task finishes
+struct TaskFinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+    template<typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+        auto continuation = handle.promise().continuation;
+        return continuation ? continuation : std::noop_coroutine();
+    }
+    void await_resume() noexcept {}
+};
+
+template<typename T>
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    TaskFinalAwaiter final_suspend() noexcept { return {}; }
+
+    void unhandled_exception() { error = std::current_exception(); }
+};
+
+template<typename T>
+struct TaskPromise : TaskPromiseBase<T> {
+    std::optional<T> value;
+
+    Task<T> get_return_object();
+    template<typename U>
+    void return_value(U&& v) { value.emplace(std::forward<U>(v)); }
+
+    T result() {
+        if (this->error) std::rethrow_exception(this->error);
+        return std::move(*value);
+    }
+};
+
+template<>
+struct TaskPromise<void> : TaskPromiseBase<void> {
+    Task<void> get_return_object();
+    void return_void() {}
+
+    void result() {
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+}  // namespace detail
+
+template<typename T>
+class Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    explicit Task(Handle handle) : handle_(handle) {}
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    ~Task() {
+        if (handle_) handle_.destroy();
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept {
+        handle_.promise().continuation = continuation;
+        return handle_;
+    }
+
+    T await_resume() { return handle_.promise().result(); }
+
+private:
+    Handle handle_;
+};
+
+namespace detail {
+
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object() {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+// Eager coroutine that frees itself when it finishes
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+template<typename T>
+Detached run_detached(Task<T> task, AsyncCallback<T> done) {
+    std::exception_ptr error;
+    std::optional<T> result;
+    try {
+        result.emplace(co_await std::move(task));
+    } catch (...) {
+        error = std::current_exception();
+    }
+    if (done) {
+        done(error, error ? T() : std::move(*result));
+    } else if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+inline Detached run_detached(Task<void> task, std::function<void(std::exception_ptr)> done) {
+    std::exception_ptr error;
+    try {
+        co_await std::move(task);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    if (done) {
+        done(error);
+    } else if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+}  // namespace detail
+
+// Start a task without awaiting it. done receives its result; without done an
+// escaping exception terminates.
+template<typename T>
+void spawn(Task<T> task, std::type_identity_t<AsyncCallback<T>> done = {}) {
+    detail::run_detached(std::move(task), std::move(done));
+}
+
+inline void spawn(Task<void> task, std::function<void(std::exception_ptr)> done = {}) {
+    detail::run_detached(std::move(task), std::move(done));
+}
+
+#endif  // DOME_HAS_COROUTINES
+
+}  // namespace dome
+
+#endif  // DOME_ASYNC_HPP
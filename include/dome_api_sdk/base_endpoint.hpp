@@ -14,14 +14,16 @@ public:
     virtual ~BaseEndpoint() = default;
 
 protected:
+    friend class PolymarketClient;  // warms the connections its endpoints share
+
     std::shared_ptr<HttpClient> http_client_;
     DomeSDKConfig config_;
 
     // Helper to build query params from optional values
     template<typename T>
-    void add_param_if_present(std::map<std::string, std::string>& params,
-                              const std::string& key,
-                              const std::optional<T>& value) {
+    static void add_param_if_present(std::map<std::string, std::string>& params,
+                                     const std::string& key,
+                                     const std::optional<T>& value) {
         if (value.has_value()) {
             if constexpr (std::is_same_v<T, std::string>) {
                 params[key] = value.value();
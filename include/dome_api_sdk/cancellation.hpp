@@ -0,0 +1,131 @@
+#ifndef DOME_CANCELLATION_HPP
+#define DOME_CANCELLATION_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace dome {
+
+/**
+ * Shared flag for aborting requests.
+ *
+ * Pass copies in RequestConfig::cancellation; cancel() on any copy aborts every
+ * request carrying it. A waiting request is dropped and a running one has its
+ * transfer stopped and its connection freed, and each fails with a DomeAPIError.
+ * A default-constructed token can never be cancelled. Thread-safe.
+ */
+class CancellationToken {
+public:
+    CancellationToken() = default;
+
+    static CancellationToken create() {
+        CancellationToken token;
+        token.state_ = std::make_shared<State>();
+        return token;
+    }
+
+    // Set the flag and run the subscribed callbacks; later calls do nothing
+    void cancel() const {
+        if (!state_) {
+            return;
+        }
+        std::map<uint64_t, std::function<void()>> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            if (state_->cancelled) {
+                return;
+            }
+            state_->cancelled = true;
+            callbacks.swap(state_->callbacks);
+            state_->notifying = std::this_thread::get_id();
+        }
+        for (auto& [id, callback] : callbacks) {
+            callback();
+        }
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            state_->notifying = std::thread::id();
+        }
+        state_->notified.notify_all();
+    }
+
+    bool cancelled() const {
+        if (!state_) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->cancelled;
+    }
+
+    bool can_be_cancelled() const { return state_ != nullptr; }
+
+    // Run callback once on cancellation, right away if already cancelled.
+    // Returns an id for unsubscribe (0 when the callback will never run).
+    uint64_t subscribe(std::function<void()> callback) const {
+        if (!state_) {
+            return 0;
+        }
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            if (!state_->cancelled) {
+                uint64_t id = state_->next_id++;
+                state_->callbacks.emplace(id, std::move(callback));
+                return id;
+            }
+        }
+        callback();
+        return 0;
+    }
+
+    // Remove a callback. When it is running on another thread, wait until it returns.
+    void unsubscribe(uint64_t id) const {
+        if (!state_ || id == 0) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        if (state_->callbacks.erase(id) > 0 || state_->notifying == std::this_thread::get_id()) {
+            return;
+        }
+        state_->notified.wait(lock, [this] { return state_->notifying == std::thread::id(); });
+    }
+
+private:
+    struct State {
+        std::mutex mutex;
+        std::condition_variable notified;
+        bool cancelled = false;
+        std::map<uint64_t, std::function<void()>> callbacks;
+        uint64_t next_id = 1;
+        std::thread::id notifying;  // thread running the callbacks, if any
+    };
+
+    std::shared_ptr<State> state_;
+};
+
+/**
+ * Subscription to a CancellationToken, removed on destruction.
+ */
+class CancellationCallback {
+public:
+    CancellationCallback() = default;
+    CancellationCallback(CancellationToken token, std::function<void()> callback)
+        : token_(std::move(token)), id_(token_.subscribe(std::move(callback))) {}
+    ~CancellationCallback() { token_.unsubscribe(id_); }
+
+    CancellationCallback(const CancellationCallback&) = delete;
+    CancellationCallback& operator=(const CancellationCallback&) = delete;
+
+private:
+    CancellationToken token_;
+    uint64_t id_ = 0;
+};
+
+}  // namespace dome
+
+#endif  // DOME_CANCELLATION_HPP
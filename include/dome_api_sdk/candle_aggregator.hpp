@@ -0,0 +1,128 @@
+#ifndef DOME_CANDLE_AGGREGATOR_HPP
+#define DOME_CANDLE_AGGREGATOR_HPP
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <functional>
+#include <unordered_map>
+#include <mutex>
+
+#include "types.hpp"
+
+namespace dome {
+
+/**
+ * OHLCV candle built from trades.
+ *
+ * @param start_time Start of the candle period (Unix seconds)
+ * @param open Price of the earliest trade
+ * @param high Highest trade price
+ * @param low Lowest trade price
+ * @param close Price of the latest trade
+ * @param volume Traded shares (normalized)
+ * @param notional Traded dollar amount (price * shares)
+ * @param trades Number of trades
+ */
+struct Candle {
+    int64_t start_time = 0;
+    Decimal open;
+    Decimal high;
+    Decimal low;
+    Decimal close;
+    Decimal volume;
+    Decimal notional;
+    int64_t trades = 0;
+};
+
+/**
+ * Options for CandleAggregator.
+ *
+ * @param interval_seconds Candle length in seconds (any positive value)
+ * @param capacity Candles retained per token (ring buffer size)
+ */
+struct CandleAggregatorOptions {
+    int64_t interval_seconds = 60;
+    size_t capacity = 1440;
+};
+
+/**
+ * In-process OHLCV aggregator fed by live order events.
+ *
+ * Keeps rolling candles at an arbitrary interval per token (and its condition_id)
+ * in a fixed-size ring buffer. Each trade is folded in O(1); trades that arrive
+ * late land in their own period as long as it is still retained. Periods with
+ * no trades are not materialized. Seed it from get_orders / get_candlesticks
+ * history, then attach it to DomeWebSocket:
+ *
+ *   ws.set_order_event_callback([&](const WebSocketOrderEvent& e) { aggregator.on_order_event(e); });
+ *
+ * All methods are thread-safe.
+ */
+class CandleAggregator {
+public:
+    using CandleClosedCallback =
+        std::function<void(const std::string& condition_id, const std::string& token_id, const Candle&)>;
+
+    explicit CandleAggregator(CandleAggregatorOptions options = {});
+
+    // Fold one trade into its candle
+    void add_trade(const std::string& condition_id, const std::string& token_id,
+                   int64_t timestamp, Decimal price, Decimal shares);
+
+    void on_order(const Order& order);
+    void on_order_event(const WebSocketOrderEvent& event);
+
+    // Seed from historical orders (any order of arrival)
+    void seed(const OrdersResponse& orders);
+
+    // Seed a token's candles from server candlesticks. source_interval_minutes must
+    // divide the aggregator interval (e.g. 1m candles into 5m candles).
+    void seed(const std::string& condition_id, const std::string& token_id,
+              const CandlesticksResponse& candlesticks, int source_interval_minutes);
+
+    // Retained candles for a token, oldest first
+    std::vector<Candle> candles(const std::string& token_id) const;
+
+    // Most recent candle for a token
+    std::optional<Candle> latest(const std::string& token_id) const;
+
+    // Invoked when a trade opens a newer period, with the candle that just closed
+    void set_candle_closed_callback(CandleClosedCallback callback);
+
+    int64_t interval_seconds() const { return options_.interval_seconds; }
+
+private:
+    struct Slot {
+        Candle candle;
+        int64_t first_trade_time = 0;
+        int64_t last_trade_time = 0;
+        bool filled = false;
+    };
+
+    struct Series {
+        std::string condition_id;
+        std::vector<Slot> ring;
+        size_t head = 0;   // index of the oldest slot
+        size_t count = 0;
+
+        Slot& at(size_t i) { return ring[(head + i) % ring.size()]; }
+        const Slot& at(size_t i) const { return ring[(head + i) % ring.size()]; }
+    };
+
+    int64_t period_start(int64_t timestamp) const;
+    // Slot for a period, creating it if it is newer than anything retained.
+    // Returns nullptr for periods older than the retained window. Sets closed if a candle closed.
+    Slot* slot_for(Series& series, int64_t start, std::optional<Candle>& closed);
+    void merge(Slot& slot, int64_t first_time, int64_t last_time, Decimal open, Decimal high,
+               Decimal low, Decimal close, Decimal volume, Decimal notional, int64_t trades);
+
+    CandleAggregatorOptions options_;
+    std::unordered_map<std::string, Series> series_;
+    CandleClosedCallback closed_callback_;
+    mutable std::mutex mutex_;
+};
+
+}  // namespace dome
+
+#endif  // DOME_CANDLE_AGGREGATOR_HPP
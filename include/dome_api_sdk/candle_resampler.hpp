@@ -0,0 +1,52 @@
+#ifndef DOME_CANDLE_RESAMPLER_HPP
+#define DOME_CANDLE_RESAMPLER_HPP
+
+#include <vector>
+
+#include "types.hpp"
+
+namespace dome {
+
+/**
+ * Roll candlesticks up into one or more coarser intervals in a single pass.
+ *
+ * Output bars are aligned to multiples of the target interval since the Unix
+ * epoch and keep the get_candlesticks conventions: end_period_ts is the end of
+ * the bar, open/previous come from the first source bar, close and
+ * open_interest from the last, high/low are the extremes, volume is summed and
+ * mean is the volume-weighted average rounded to the nearest unit (a plain average
+ * when the bar has no volume). The yes_ask/yes_bid OHLC roll up the same way.
+ * Periods with no source bars are skipped, so gaps in the input stay gaps.
+ *
+ * Each source bar costs a few comparisons and adds per interval; bucket ends are
+ * only computed when a bar opens a new bucket. The loop is scalar: bars are
+ * structs of 17 fields that roll up differently (first, last, max, min, sum),
+ * so there is no contiguous column to run SIMD over without first copying the
+ * input apart.
+ *
+ * @param candlesticks Source bars; sorted by end_period_ts if not already (on a copy)
+ * @param count Number of source bars
+ * @param source_interval_minutes Interval of the source bars (e.g. 1)
+ * @param target_interval_minutes Intervals to produce (e.g. {5, 15, 240}); each
+ *        must be a multiple of the source interval. Throws std::invalid_argument otherwise.
+ * @return One vector of bars per target interval, in the order requested
+ */
+std::vector<std::vector<CandlestickData>> resample_candlesticks(
+    const CandlestickData* candlesticks,
+    size_t count,
+    int source_interval_minutes,
+    const std::vector<int>& target_interval_minutes);
+
+std::vector<std::vector<CandlestickData>> resample_candlesticks(
+    const std::vector<CandlestickData>& candlesticks,
+    int source_interval_minutes,
+    const std::vector<int>& target_interval_minutes);
+
+std::vector<std::vector<CandlestickData>> resample_candlesticks(
+    const CandlesticksResponse& response,
+    int source_interval_minutes,
+    const std::vector<int>& target_interval_minutes);
+
+}  // namespace dome
+
+#endif  // DOME_CANDLE_RESAMPLER_HPP
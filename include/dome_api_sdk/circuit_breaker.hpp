@@ -0,0 +1,99 @@
+#ifndef DOME_CIRCUIT_BREAKER_HPP
+#define DOME_CIRCUIT_BREAKER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "types.hpp"
+
+namespace dome {
+
+/**
+ * Options for CircuitBreaker.
+ *
+ * @param window Recent outcomes kept per endpoint
+ * @param min_calls Outcomes needed in the window before the circuit can open
+ * @param failure_ratio Share of OVERLOADED outcomes in the window that opens the circuit
+ * @param open_duration How long an open circuit rejects calls before letting a probe through
+ */
+struct CircuitBreakerOptions {
+    size_t window = 20;
+    size_t min_calls = 10;
+    double failure_ratio = 0.5;
+    std::chrono::milliseconds open_duration{5000};
+};
+
+/**
+ * Thrown instead of sending a request while its endpoint's circuit is open.
+ *
+ * @param route Endpoint whose circuit is open, e.g. "/polymarket/orders"
+ * @param retry_after Time until the circuit lets a probe through
+ */
+class CircuitOpenError : public DomeAPIError {
+public:
+    std::string route;
+    std::chrono::milliseconds retry_after;
+
+    CircuitOpenError(const std::string& route, std::chrono::milliseconds retry_after);
+};
+
+/**
+ * Per-endpoint circuit breaker.
+ *
+ * Endpoints are keyed by their first two path segments, so every token of
+ * /polymarket/market-price/{token_id} shares a circuit. A circuit opens when
+ * enough of its recent outcomes are OVERLOADED (429, 5xx, timeouts, transport
+ * failures), and then fails calls fast with CircuitOpenError. After
+ * open_duration a single probe call is let through: success closes the circuit,
+ * another overload opens it again. The probe is identified by the ticket allow()
+ * returned for it, so calls admitted before the circuit opened cannot decide in
+ * its place. Share one breaker between clients through
+ * DomeSDKConfig::circuit_breaker. Thread-safe.
+ */
+class CircuitBreaker {
+    struct State;
+
+public:
+    enum class Status {
+        CLOSED,
+        OPEN,
+        HALF_OPEN
+    };
+
+    // Identifies an admitted call to record(); nonzero only for a probe
+    using Ticket = uint64_t;
+
+    explicit CircuitBreaker(CircuitBreakerOptions options = {});
+    ~CircuitBreaker();
+
+    CircuitBreaker(const CircuitBreaker&) = delete;
+    CircuitBreaker& operator=(const CircuitBreaker&) = delete;
+
+    // Admit a call, or throw CircuitOpenError while the circuit is open or its
+    // probe is running. Every admitted call must be followed by record() with
+    // the returned ticket.
+    Ticket allow(const std::string& route);
+
+    // Outcome of a call admitted by allow()
+    void record(const std::string& route, RequestOutcome outcome, Ticket ticket = 0);
+
+    Status status(const std::string& route) const;
+
+    // Close every circuit and forget their outcomes
+    void reset();
+
+    const CircuitBreakerOptions& options() const { return options_; }
+
+    // Circuit key for a request path: its first two segments, without the query
+    static std::string route_of(const std::string& endpoint);
+
+private:
+    CircuitBreakerOptions options_;
+    std::unique_ptr<State> state_;
+};
+
+}  // namespace dome
+
+#endif  // DOME_CIRCUIT_BREAKER_HPP
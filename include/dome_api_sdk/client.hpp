@@ -19,6 +19,9 @@ public:
     // Public sub-client for Polymarket
     PolymarketClient polymarket;
 
+    // Open connections to the API ahead of the first request (see ConnectionPool)
+    size_t warmup(size_t connections = 4) { return polymarket.warmup(connections); }
+
 private:
     DomeSDKConfig config_;
     
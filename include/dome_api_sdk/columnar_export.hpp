@@ -0,0 +1,166 @@
+#ifndef DOME_COLUMNAR_EXPORT_HPP
+#define DOME_COLUMNAR_EXPORT_HPP
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+
+#include "types.hpp"
+#include "orders_endpoints.hpp"
+#include "activity_endpoints.hpp"
+
+namespace dome {
+
+/**
+ * Variable-length string column in Arrow utf8 layout.
+ *
+ * Row i spans data[offsets[i], offsets[i + 1]). The buffers can be handed to
+ * arrow::StringArray (or written to Parquet) without a per-row copy.
+ *
+ * @param offsets Row offsets into data (size is rows + 1)
+ * @param data Concatenated UTF-8 bytes of all rows
+ */
+struct StringColumn {
+    std::vector<int32_t> offsets{0};
+    std::string data;
+
+    void append(const std::string& value);
+    std::string at(size_t row) const;
+    size_t size() const { return offsets.size() - 1; }
+    void clear();
+};
+
+/**
+ * Dictionary-encoded string column.
+ *
+ * Maps to arrow::DictionaryArray with int32 indices. Each batch carries its own
+ * dictionary, so memory stays bounded by the batch size.
+ *
+ * @param dictionary Distinct values in first-seen order
+ * @param indices Per-row index into dictionary
+ */
+class DictionaryColumn {
+public:
+    StringColumn dictionary;
+    std::vector<int32_t> indices;
+
+    void append(const std::string& value);
+    std::string at(size_t row) const;
+    size_t size() const { return indices.size(); }
+    void clear();
+
+private:
+    std::unordered_map<std::string, int32_t> lookup_;
+};
+
+/**
+ * Columnar batch of orders.
+ *
+ * @param token_id Token IDs (dictionary encoded)
+ * @param token_label Outcome labels (dictionary encoded)
+ * @param side Order sides (dictionary encoded)
+ * @param market_slug Market slugs (dictionary encoded)
+ * @param condition_id Condition IDs (dictionary encoded)
+ * @param title Market titles (dictionary encoded)
+ * @param shares Raw share quantities
+ * @param shares_normalized Normalized share quantities as raw Decimal units (decimal(18, 6))
+ * @param price Prices as raw Decimal units (decimal(18, 6))
+ * @param tx_hash Transaction hashes
+ * @param timestamp Timestamps
+ * @param order_hash Order hashes
+ * @param user Maker addresses
+ * @param taker Taker addresses (empty where taker_valid is 0)
+ * @param taker_valid Validity flags for taker
+ */
+struct OrderColumnBatch {
+    DictionaryColumn token_id;
+    DictionaryColumn token_label;
+    DictionaryColumn side;
+    DictionaryColumn market_slug;
+    DictionaryColumn condition_id;
+    DictionaryColumn title;
+    std::vector<int64_t> shares;
+    std::vector<int64_t> shares_normalized;
+    std::vector<int64_t> price;
+    StringColumn tx_hash;
+    std::vector<int64_t> timestamp;
+    StringColumn order_hash;
+    StringColumn user;
+    StringColumn taker;
+    std::vector<uint8_t> taker_valid;
+
+    void append(const Order& order);
+    void reserve(size_t rows);
+    size_t rows() const { return timestamp.size(); }
+    void clear();
+};
+
+/**
+ * Columnar batch of activities.
+ *
+ * @param token_id Token IDs (dictionary encoded)
+ * @param side Activity sides (dictionary encoded)
+ * @param market_slug Market slugs (dictionary encoded)
+ * @param condition_id Condition IDs (dictionary encoded)
+ * @param title Market titles (dictionary encoded)
+ * @param shares Raw share quantities
+ * @param shares_normalized Normalized share quantities as raw Decimal units (decimal(18, 6))
+ * @param price Prices as raw Decimal units (decimal(18, 6))
+ * @param tx_hash Transaction hashes
+ * @param timestamp Timestamps
+ * @param order_hash Order hashes
+ * @param user User addresses
+ */
+struct ActivityColumnBatch {
+    DictionaryColumn token_id;
+    DictionaryColumn side;
+    DictionaryColumn market_slug;
+    DictionaryColumn condition_id;
+    DictionaryColumn title;
+    std::vector<int64_t> shares;
+    std::vector<int64_t> shares_normalized;
+    std::vector<int64_t> price;
+    StringColumn tx_hash;
+    std::vector<int64_t> timestamp;
+    StringColumn order_hash;
+    StringColumn user;
+
+    void append(const Activity& activity);
+    void reserve(size_t rows);
+    size_t rows() const { return timestamp.size(); }
+    void clear();
+};
+
+/**
+ * Options for columnar export.
+ *
+ * @param batch_rows Maximum rows per emitted batch (bounds memory use)
+ * @param page_size Rows requested per API page
+ */
+struct ColumnarExportOptions {
+    size_t batch_rows = 65536;
+    int page_size = 1000;
+};
+
+using OrderBatchCallback = std::function<void(const OrderColumnBatch&)>;
+using ActivityBatchCallback = std::function<void(const ActivityColumnBatch&)>;
+
+// Page through get_orders and emit columnar batches. Returns the number of rows exported.
+// The batch passed to the callback is reused after it returns.
+size_t export_orders(OrdersEndpoints& endpoints,
+                     GetOrdersParams params,
+                     const OrderBatchCallback& on_batch,
+                     const ColumnarExportOptions& options = {});
+
+// Page through get_activity and emit columnar batches. Returns the number of rows exported.
+// The batch passed to the callback is reused after it returns.
+size_t export_activity(ActivityEndpoints& endpoints,
+                       GetActivityParams params,
+                       const ActivityBatchCallback& on_batch,
+                       const ColumnarExportOptions& options = {});
+
+}  // namespace dome
+
+#endif  // DOME_COLUMNAR_EXPORT_HPP
@@ -0,0 +1,92 @@
+#ifndef DOME_DECIMAL_HPP
+#define DOME_DECIMAL_HPP
+
+#include <string>
+#include <string_view>
+#include <ostream>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+namespace dome {
+
+/**
+ * Fixed-point decimal with 6 fractional digits, stored in one int64.
+ *
+ * Covers prices, normalized share counts (raw blockchain quantity / 1e6) and
+ * dollar amounts exactly, with a range of about +/-9.2e12. Values are parsed
+ * straight from their decimal text, so "0.5300" round-trips without going
+ * through a double; from_double is the only conversion that rounds. Multiplication and division round half away from zero.
+ */
+class Decimal {
+public:
+    static constexpr int kScale = 6;
+    static constexpr int64_t kOne = 1000000;
+
+    constexpr Decimal() = default;
+
+    // Construct from raw units (value * 1e6). Order::shares maps to shares_normalized this way.
+    static constexpr Decimal from_raw(int64_t units) { return Decimal(units); }
+    // Throws std::out_of_range beyond +/-9.2e12
+    static constexpr Decimal from_int(int64_t value) {
+        if (value > std::numeric_limits<int64_t>::max() / kOne ||
+            value < std::numeric_limits<int64_t>::min() / kOne) {
+            throw std::out_of_range("Decimal out of range: " + std::to_string(value));
+        }
+        return Decimal(value * kOne);
+    }
+    // Round a double to the nearest representable value
+    static Decimal from_double(double value);
+
+    // Parse decimal text such as "0.53", "-12", "1e-3". Throws std::invalid_argument.
+    static Decimal parse(std::string_view text);
+    // Parse decimal text, returning false on malformed or out-of-range input
+    static bool try_parse(std::string_view text, Decimal& out);
+
+    constexpr int64_t raw() const { return units_; }
+    double to_double() const { return static_cast<double>(units_) / kOne; }
+    // Shortest exact text form, e.g. "0.53", "12", "-0.000001"
+    std::string to_string() const;
+
+    constexpr bool is_zero() const { return units_ == 0; }
+
+    constexpr Decimal operator-() const { return Decimal(-units_); }
+    constexpr Decimal operator+(Decimal other) const { return Decimal(units_ + other.units_); }
+    constexpr Decimal operator-(Decimal other) const { return Decimal(units_ - other.units_); }
+    Decimal operator*(Decimal other) const;
+    Decimal operator/(Decimal other) const;
+    constexpr Decimal operator*(int64_t factor) const { return Decimal(units_ * factor); }
+
+    Decimal& operator+=(Decimal other) { units_ += other.units_; return *this; }
+    Decimal& operator-=(Decimal other) { units_ -= other.units_; return *this; }
+    Decimal& operator*=(Decimal other) { return *this = *this * other; }
+    Decimal& operator/=(Decimal other) { return *this = *this / other; }
+
+    constexpr bool operator==(Decimal other) const { return units_ == other.units_; }
+    constexpr bool operator!=(Decimal other) const { return units_ != other.units_; }
+    constexpr bool operator<(Decimal other) const { return units_ < other.units_; }
+    constexpr bool operator<=(Decimal other) const { return units_ <= other.units_; }
+    constexpr bool operator>(Decimal other) const { return units_ > other.units_; }
+    constexpr bool operator>=(Decimal other) const { return units_ >= other.units_; }
+
+    friend std::ostream& operator<<(std::ostream& os, Decimal value) { return os << value.to_string(); }
+
+private:
+    constexpr explicit Decimal(int64_t units) : units_(units) {}
+
+    int64_t units_ = 0;
+};
+
+}  // namespace dome
+
+namespace std {
+template<>
+struct hash<dome::Decimal> {
+    size_t operator()(dome::Decimal value) const noexcept {
+        return std::hash<int64_t>{}(value.raw());
+    }
+};
+}  // namespace std
+
+#endif  // DOME_DECIMAL_HPP
@@ -0,0 +1,22 @@
+#ifndef DOME_DECODE_HPP
+#define DOME_DECODE_HPP
+
+#include <nlohmann/json.hpp>
+#include "types.hpp"
+
+namespace dome {
+
+// Record decoders shared by the REST endpoints and DomeWebSocket.
+// When intern_table is set, repeated identifiers share one interned buffer.
+
+Order decode_order(const nlohmann::json& item, InternTable* intern_table = nullptr);
+
+Activity decode_activity(const nlohmann::json& item, InternTable* intern_table = nullptr);
+
+CandlestickData decode_candlestick(const nlohmann::json& item);
+
+OrderbookSnapshot decode_orderbook_snapshot(const nlohmann::json& item);
+
+}  // namespace dome
+
+#endif  // DOME_DECODE_HPP
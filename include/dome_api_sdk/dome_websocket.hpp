@@ -11,6 +11,7 @@
 
 #include "websocket_client.hpp"
 #include "types.hpp"
+#include "token_index.hpp"
 
 namespace dome {
 
@@ -32,6 +33,7 @@ class DomeWebSocket {
 public:
     using AckCallback = std::function<void(const std::string& subscription_id)>;
     using OrderEventCallback = std::function<void(const WebSocketOrderEvent&)>;
+    using EnrichedOrderEventCallback = std::function<void(const WebSocketOrderEvent&, const TokenMatch&)>;
     using ErrorCallback = std::function<void(const std::string&)>;
     using ConnectedCallback = std::function<void()>;
     using DisconnectedCallback = std::function<void()>;
@@ -76,13 +78,27 @@ public:
 
     // Callback setters
     void set_order_event_callback(OrderEventCallback callback);
+    void set_enriched_order_event_callback(EnrichedOrderEventCallback callback);
     void set_ack_callback(AckCallback callback);
     void set_error_callback(ErrorCallback callback);
     void set_connected_callback(ConnectedCallback callback);
     void set_disconnected_callback(DisconnectedCallback callback);
 
-    // Get current active subscriptions
-    const std::map<std::string, ActiveSubscription>& get_subscriptions() const;
+    /**
+     * Share identifier strings of decoded order events through an intern table.
+     * @param intern_table Table to intern into, or nullptr to disable
+     */
+    void set_intern_table(std::shared_ptr<InternTable> intern_table);
+
+    /**
+     * Resolve each order event's token_id to its market and side before invoking
+     * the enriched order event callback. Unknown tokens yield an empty TokenMatch.
+     * @param token_index Index to look up in (e.g. MarketCatalog::token_index()), or nullptr
+     */
+    void set_token_index(std::shared_ptr<const TokenIndex> token_index);
+
+    // Get a copy of the current active subscriptions
+    std::map<std::string, ActiveSubscription> get_subscriptions() const;
 
 private:
     void on_message(const std::string& message);
@@ -97,13 +113,25 @@ private:
     std::map<std::string, ActiveSubscription> subscriptions_;
     SubscribeFilters pending_filters_;  // Filters for pending subscription (before ack)
     
-    OrderEventCallback order_event_callback_;
-    AckCallback ack_callback_;
-    ErrorCallback error_callback_;
-    ConnectedCallback connected_callback_;
-    DisconnectedCallback disconnected_callback_;
-    
-    mutable std::mutex mutex_;
+    // Callbacks and lookup tables, replaced as a whole by the setters so the
+    // message thread only locks to load the snapshot and calls them unlocked
+    struct Handlers {
+        OrderEventCallback order_event;
+        EnrichedOrderEventCallback enriched_order_event;
+        AckCallback ack;
+        ErrorCallback error;
+        ConnectedCallback connected;
+        DisconnectedCallback disconnected;
+        std::shared_ptr<InternTable> intern_table;
+        std::shared_ptr<const TokenIndex> token_index;
+    };
+
+    std::shared_ptr<const Handlers> handlers() const;
+    void update_handlers(const std::function<void(Handlers&)>& update);
+
+    std::shared_ptr<const Handlers> handlers_;  // accessed with std::atomic_load/store
+
+    mutable std::mutex mutex_;  // guards subscriptions_, pending_filters_ and handler updates
 };
 
 }  // namespace dome
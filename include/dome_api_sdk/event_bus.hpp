@@ -0,0 +1,179 @@
+#ifndef DOME_EVENT_BUS_HPP
+#define DOME_EVENT_BUS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <variant>
+
+#include "types.hpp"
+
+namespace dome {
+
+/**
+ * Mark price of a token, e.g. from get_market_price.
+ *
+ * @param token_id Token ID
+ * @param price Price at at_time
+ * @param at_time Unix timestamp in seconds
+ */
+struct PriceMark {
+    std::string token_id;
+    double price = 0;
+    int64_t at_time = 0;
+};
+
+using BusPayload = std::variant<WebSocketOrderEvent, Activity, PriceMark>;
+
+/**
+ * Event delivered by an EventBus.
+ *
+ * @param source ID of the EventBus::Source that published it
+ * @param sequence Per-source number starting at 1; a gap means events were dropped
+ *        (a full source inbox or a full subscription)
+ * @param timestamp Event time in Unix seconds: the order or activity timestamp, or the
+ *        price's at_time
+ * @param late Released after an event with a newer timestamp, i.e. it arrived more
+ *        than the reorder window behind
+ * @param payload The order event, activity or price mark
+ */
+struct BusEvent {
+    uint32_t source = 0;
+    uint64_t sequence = 0;
+    int64_t timestamp = 0;
+    bool late = false;
+    BusPayload payload;
+};
+
+/**
+ * Options for EventBus.
+ *
+ * @param reorder_window How long each event is held to let older events from slower
+ *        sources overtake it (0 = deliver in arrival order)
+ * @param max_held Events held for reordering at most; beyond it the oldest go out early
+ * @param source_capacity Events each source can have waiting for the dispatcher
+ * @param subscriber_capacity Events each subscription can have waiting for its consumer
+ */
+struct EventBusOptions {
+    std::chrono::milliseconds reorder_window{50};
+    size_t max_held = 65536;
+    size_t source_capacity = 4096;
+    size_t subscriber_capacity = 4096;
+};
+
+/**
+ * Merges order events, activity and price marks from several producers into one
+ * timestamp-ordered stream for several consumers.
+ *
+ * Each source has a lock-free single-producer inbox, so publishing never blocks
+ * a WebSocket or polling thread. A dispatcher (start(), or pump() on a thread of
+ * your own) moves events into a min-heap by timestamp and arrival and releases
+ * each after it has been held for the reorder window. Released events are shared
+ * (not copied) into every subscription's lock-free ring. A consumer that falls
+ * behind loses events from its own ring only, which shows as sequence gaps.
+ *
+ *   dome::EventBus bus;
+ *   auto ws_source = bus.add_source("websocket");
+ *   ws.set_order_event_callback(ws_source->order_callback());
+ *   auto subscription = bus.subscribe();
+ *   bus.start();
+ *   std::shared_ptr<const dome::BusEvent> event;
+ *   while (subscription->wait_pop(event, std::chrono::seconds(1))) { ... }
+ *
+ * add_source, subscribe, start and stop are thread-safe; sources and
+ * subscriptions stay usable after the bus is destroyed, but nothing flows.
+ */
+class EventBus {
+    struct State;
+
+public:
+    // Publishing handle. Publish from one thread at a time; add a source per thread.
+    class Source : public std::enable_shared_from_this<Source> {
+    public:
+        ~Source();
+
+        Source(const Source&) = delete;
+        Source& operator=(const Source&) = delete;
+
+        uint32_t id() const { return id_; }
+        const std::string& name() const { return name_; }
+
+        // Queue an event for the dispatcher; false (and a sequence gap) when the inbox is full
+        bool publish(WebSocketOrderEvent event);
+        bool publish(Activity activity);
+        bool publish(PriceMark mark);
+
+        // Callbacks for DomeWebSocket, IncrementalPoller and the like that publish here
+        OrderEventCallback order_callback();
+        std::function<void(const Activity&)> activity_callback();
+
+        // Events refused because the inbox was full
+        uint64_t dropped() const;
+
+    private:
+        friend class EventBus;
+        struct Inbox;
+        Source(std::shared_ptr<State> state, uint32_t id, std::string name);
+        bool publish(int64_t timestamp, BusPayload payload);
+
+        std::shared_ptr<State> state_;
+        std::shared_ptr<Inbox> inbox_;
+        uint32_t id_;
+        std::string name_;
+        uint64_t next_sequence_ = 1;
+    };
+
+    // One consumer's queue. Pop from one thread at a time; unsubscribes on destruction.
+    class Subscription {
+    public:
+        ~Subscription();
+
+        Subscription(const Subscription&) = delete;
+        Subscription& operator=(const Subscription&) = delete;
+
+        bool try_pop(std::shared_ptr<const BusEvent>& event);
+
+        // Wait up to timeout for an event
+        bool wait_pop(std::shared_ptr<const BusEvent>& event, std::chrono::milliseconds timeout);
+
+        // Events lost because this subscription's ring was full
+        uint64_t dropped() const;
+
+    private:
+        friend class EventBus;
+        struct Ring;
+        Subscription(std::shared_ptr<State> state, std::shared_ptr<Ring> ring);
+
+        std::shared_ptr<State> state_;
+        std::shared_ptr<Ring> ring_;
+    };
+
+    explicit EventBus(EventBusOptions options = {});
+    ~EventBus();
+
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    std::shared_ptr<Source> add_source(const std::string& name);
+    std::unique_ptr<Subscription> subscribe();
+
+    // Run the dispatcher on a background thread until stopped
+    void start();
+    void stop();
+
+    // Dispatch on this thread instead of start(): take what the sources queued and
+    // deliver the events whose reorder window has passed. Returns how many were delivered.
+    size_t pump();
+
+    const EventBusOptions& options() const { return options_; }
+
+private:
+    EventBusOptions options_;
+    std::shared_ptr<State> state_;
+};
+
+}  // namespace dome
+
+#endif  // DOME_EVENT_BUS_HPP
@@ -3,32 +3,313 @@
 
 #include <string>
 #include <map>
+#include <vector>
+#include <optional>
+#include <memory>
+#include <string_view>
+#include <initializer_list>
+#include <utility>
+#include <functional>
+#include <chrono>
+#include <mutex>
 #include <nlohmann/json.hpp>
 #include "types.hpp"
+#include "async.hpp"
+#include "circuit_breaker.hpp"
+#include "request_scheduler.hpp"
 
 namespace dome {
 
+/**
+ * One GET request in a batch.
+ *
+ * @param endpoint Endpoint path
+ * @param query_params Query parameters
+ */
+struct BatchRequest {
+    std::string endpoint;
+    std::map<std::string, std::string> query_params;
+};
+
+/**
+ * Result of one batched request. error is set when the request failed,
+ * otherwise body holds the parsed response.
+ *
+ * @param body Parsed JSON response
+ * @param error Error the request would have thrown
+ */
+struct BatchResult {
+    nlohmann::json body;
+    std::optional<DomeAPIError> error;
+};
+
+/**
+ * Options for HttpClient::get_many.
+ *
+ * @param max_concurrency Requests in flight at once, which also caps connections to the host
+ * @param requests_per_second Maximum rate at which requests are started (0 = unlimited)
+ */
+struct BatchOptions {
+    size_t max_concurrency = 16;
+    double requests_per_second = 0;
+};
+
+// Headers, encodings, stats and pool used by requests; immutable once published
+struct RequestSettings;
+
+/**
+ * Connections, DNS results and TLS sessions reused by the requests of the clients
+ * that use it.
+ *
+ * DNS results and TLS sessions are shared by every handle. Connections are not:
+ * libcurl cannot share a connection cache between threads, so the pool keeps
+ * lanes (a curl multi and easy handle pair) that a blocking request or batch checks
+ * out for its duration. Each lane keeps its connections between calls, so a
+ * connection is reused by later requests but never used by two threads at once.
+ * AsyncLoop and PreparedRequest keep connections of their own.
+ *
+ * Without warmup, the first request pays for DNS, TCP and TLS; warmup() does that
+ * ahead of time by sending HEAD requests, with the given headers, to the given URL
+ * on several lanes in parallel. Keepalive does the same periodically for lanes
+ * that have sat idle for a whole interval, so their connections are neither closed
+ * by the server nor found dead by the next real request. Lanes being warmed stay in
+ * the pool: a request that finds only those idle waits for one instead of opening
+ * a cold connection. Thread-safe.
+ *
+ * @param max_connections Idle lanes kept in the pool, each with its connections
+ */
+class ConnectionPool {
+public:
+    explicit ConnectionPool(size_t max_connections = 16);
+    ~ConnectionPool();
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    // Warm up to connections lanes in parallel, each with a connection to url's host:
+    // its idle one if still alive, otherwise a new one. Returns how many are warm;
+    // failures are not thrown.
+    size_t warmup(const std::string& url, size_t connections, long timeout_seconds = 10,
+                  const std::map<std::string, std::string>& headers = {});
+
+    // Every interval, on a background thread until stopped, re-warm the lanes left idle
+    // since the last round
+    void start_keepalive(const std::string& url, std::chrono::seconds interval,
+                         const std::map<std::string, std::string>& headers = {}, long timeout_seconds = 10);
+    void stop_keepalive();
+
+    size_t max_connections() const { return max_connections_; }
+
+private:
+    friend class HttpClient;
+    friend class PreparedRequest;
+    friend class AsyncLoop;
+    struct State;
+
+    size_t max_connections_;
+    std::unique_ptr<State> state_;
+};
+
+/**
+ * Non-blocking transport for AsyncOp requests.
+ *
+ * Requests started from any thread are queued to one curl multi handle; the
+ * thread that calls run() or run_once() performs all transfers and invokes their
+ * completions, so one thread can keep thousands of requests in flight. To embed
+ * it in another event loop, call run_once() from that loop and set an executor
+ * to post completions to it (e.g. asio::post). Requests of a client with a
+ * scheduler wait in it before they are added; ones shed at their deadline
+ * complete with an error. Requests still pending when the loop is destroyed are
+ * abandoned without completing.
+ *
+ * @param max_host_connections Connections opened per host; further requests wait
+ *        for a free one or are multiplexed over HTTP/2
+ */
+class AsyncLoop {
+public:
+    using Executor = std::function<void(std::function<void()>)>;
+
+    explicit AsyncLoop(size_t max_host_connections = 32);
+    ~AsyncLoop();
+
+    AsyncLoop(const AsyncLoop&) = delete;
+    AsyncLoop& operator=(const AsyncLoop&) = delete;
+
+    // Run completions through executor instead of inline on the loop thread; may be
+    // called from any thread, and applies to completions that run after it returns
+    void set_executor(Executor executor);
+
+    // Make progress for at most timeout and run any completions; returns the
+    // number of requests still pending
+    size_t run_once(std::chrono::milliseconds timeout = std::chrono::milliseconds(100));
+
+    // Run until no request is pending, including ones started by completions, or until stop()
+    void run();
+
+    // Make run() return; safe to call from any thread
+    void stop();
+
+    // Requests started and not yet completed
+    size_t pending() const;
+
+private:
+    friend class HttpClient;
+    struct Transfer;
+    struct State;
+
+    // Queue a configured transfer; thread-safe
+    void submit(std::unique_ptr<Transfer> transfer);
+
+    std::unique_ptr<State> state_;
+};
+
+/**
+ * A GET request whose curl handle, header list and URL prefix are built once.
+ *
+ * Each call only appends the varying path suffix and query parameters to the
+ * stored prefix and performs the transfer on the same handle, which also keeps
+ * its connection alive between calls. Created by HttpClient::prepare; headers
+ * are captured at that point. Each call's RequestConfig sets its timeouts, extra
+ * headers, cancellation and deadline; the call is not admitted through the
+ * client's scheduler.
+ * Not thread-safe: use one per thread.
+ */
+class PreparedRequest {
+public:
+    using QueryParam = std::pair<std::string_view, std::string_view>;
+
+    PreparedRequest(PreparedRequest&&) noexcept;
+    PreparedRequest& operator=(PreparedRequest&&) noexcept;
+    ~PreparedRequest();
+
+    // GET prefix + path_suffix + query and parse the JSON response
+    nlohmann::json get(std::string_view path_suffix = {},
+                       std::initializer_list<QueryParam> query_params = {},
+                       const RequestConfig& request = {});
+
+    // Same, returning the raw body (valid until the next call)
+    const std::string& get_raw(std::string_view path_suffix = {},
+                               std::initializer_list<QueryParam> query_params = {},
+                               const RequestConfig& request = {});
+
+private:
+    friend class HttpClient;
+    struct State;
+
+    PreparedRequest(std::string url_prefix, std::shared_ptr<const RequestSettings> settings, float timeout);
+
+    std::unique_ptr<State> state_;
+};
+
+/**
+ * HTTP transport for the endpoints.
+ *
+ * Safe to share between threads. Headers, encodings, stats and the connection
+ * pool live in an immutable RequestSettings snapshot: each request loads the
+ * current snapshot with std::atomic_load and keeps it for its duration, and the
+ * setters publish a modified copy. That load is not lock-free (libstdc++ guards
+ * shared_ptr atomics with a pool of mutexes), but the lock is held only for the
+ * pointer copy, never across a transfer. A setter only affects requests started
+ * after it returns. With a scheduler,
+ * requests wait for admission by priority and are shed at their deadline.
+ */
 class HttpClient {
 public:
-    HttpClient(const std::string& base_url, const std::string& api_key, float timeout = 30.0f);
+    // Requests go through pool (nullptr = a private pool for this client)
+    HttpClient(const std::string& base_url, const std::string& api_key, float timeout = 30.0f,
+               std::shared_ptr<ConnectionPool> pool = nullptr);
     ~HttpClient();
 
     // Perform a GET request
     nlohmann::json get(const std::string& endpoint, 
-                       const std::map<std::string, std::string>& query_params = {});
+                       const std::map<std::string, std::string>& query_params = {},
+                       const RequestConfig& request = {});
 
     // Perform a POST request
     nlohmann::json post(const std::string& endpoint,
                         const nlohmann::json& body = {});
 
+    // Perform a GET request and decode the body while it downloads. Each element of
+    // the top-level array named records_key is passed to on_record as soon as it is
+    // complete and then discarded; the other top-level fields are returned.
+    nlohmann::json get_streaming(const std::string& endpoint,
+                                 const std::map<std::string, std::string>& query_params,
+                                 const std::string& records_key,
+                                 const std::function<void(const nlohmann::json&)>& on_record,
+                                 const RequestConfig& request = {});
+
+    // Perform a GET request and feed the body to sax while it downloads, for decoders
+    // that build their records straight from the parser's events. Errors are thrown
+    // as by get; sax may throw to abort.
+    void get_sax(const std::string& endpoint, const std::map<std::string, std::string>& query_params,
+                 nlohmann::json_sax<nlohmann::json>& sax, const RequestConfig& request = {});
+
+    // GET without blocking: the request starts when the returned operation is
+    // started or awaited and runs on loop. The client may be destroyed before then.
+    AsyncOp<nlohmann::json> get_async(AsyncLoop& loop, const std::string& endpoint,
+                                      const std::map<std::string, std::string>& query_params = {},
+                                      const RequestConfig& request = {});
+
+    // Perform many GET requests concurrently on one lane of the connection pool.
+    // Results are returned in request order; failures do not abort the batch.
+    // request applies to each transfer: its timeouts and headers, and its cancellation
+    // and deadline, which fail the transfers still running or not yet started.
+    // With a scheduler, each transfer waits for a BULK permit.
+    std::vector<BatchResult> get_many(const std::vector<BatchRequest>& requests,
+                                      const BatchOptions& options = {},
+                                      const RequestConfig& request = {});
+
+    // Prepare a reusable GET request for base_url + endpoint_prefix
+    PreparedRequest prepare(const std::string& endpoint_prefix) const;
+
+    // Warm up, or keep alive, connections to base_url in the client's pool, sending
+    // the client's current headers; see ConnectionPool
+    size_t warmup(size_t connections);
+    void start_keepalive(std::chrono::seconds interval);
+
     // Set custom headers
     void set_header(const std::string& key, const std::string& value);
 
+    // Content encodings to accept; responses are decompressed as they arrive.
+    // Empty = every encoding libcurl supports, nullopt = uncompressed only.
+    void set_accept_encoding(std::optional<std::string> encodings);
+
+    // Record compressed and decompressed response sizes into stats (nullptr = off)
+    void set_transfer_stats(std::shared_ptr<TransferStats> stats);
+    std::shared_ptr<TransferStats> transfer_stats() const;
+
+    // Route every request through pool (nullptr = a private pool for this client)
+    void set_connection_pool(std::shared_ptr<ConnectionPool> pool);
+    std::shared_ptr<ConnectionPool> connection_pool() const;
+
+    // Defaults for calls whose RequestConfig leaves them at 0. Prepared requests keep
+    // the defaults of when they were prepared.
+    void set_connect_timeout(std::chrono::milliseconds timeout);
+    void set_first_byte_timeout(std::chrono::milliseconds timeout);
+
+    // Admit get, get_streaming and get_async calls through scheduler by their
+    // RequestConfig priority and deadline, and each get_many transfer as BULK
+    // (nullptr = start immediately)
+    void set_scheduler(std::shared_ptr<RequestScheduler> scheduler);
+    std::shared_ptr<RequestScheduler> scheduler() const;
+
+    // Fail get, get_streaming, get_async and get_many calls fast while breaker has
+    // their endpoint's circuit open (nullptr = never)
+    void set_circuit_breaker(std::shared_ptr<CircuitBreaker> breaker);
+    std::shared_ptr<CircuitBreaker> circuit_breaker() const;
+
 private:
     std::string base_url_;
     std::string api_key_;
     float timeout_;
-    std::map<std::string, std::string> headers_;
+    std::shared_ptr<const RequestSettings> settings_;  // accessed with std::atomic_load/store
+    std::mutex settings_mutex_;                          // serializes setters
+
+    // Current settings snapshot
+    std::shared_ptr<const RequestSettings> settings() const;
+
+    // Publish a copy of the settings with update applied
+    void update_settings(const std::function<void(RequestSettings&)>& update);
 
     // Build full URL with query parameters
     std::string build_url(const std::string& endpoint,
@@ -37,10 +318,12 @@ private:
     // URL encode a string
     static std::string url_encode(const std::string& value);
 
-    // Perform the actual HTTP request
-    std::string perform_request(const std::string& url, 
+    // Perform the actual HTTP request; endpoint picks the circuit
+    std::string perform_request(const std::string& endpoint,
+                                const std::string& url,
                                 HTTPMethod method,
-                                const std::string& body = "");
+                                const std::string& body = "",
+                                const RequestConfig& request = {});
 };
 
 }  // namespace dome
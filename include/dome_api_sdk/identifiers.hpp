@@ -0,0 +1,135 @@
+#ifndef DOME_IDENTIFIERS_HPP
+#define DOME_IDENTIFIERS_HPP
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <ostream>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+namespace dome {
+
+// Decode 2 * size hex digits (optionally prefixed with "0x", either case) into out
+bool decode_hex(std::string_view text, uint8_t* out, size_t size);
+
+// "0x" followed by lowercase hex digits
+std::string encode_hex(const uint8_t* data, size_t size);
+
+/**
+ * Fixed-size binary identifier parsed from 0x-prefixed hex.
+ *
+ * Hash32 holds condition IDs, tx hashes and order hashes (66 hex chars);
+ * Address20 holds wallet addresses (42 hex chars). Parsing is case-insensitive,
+ * so checksummed and lowercase addresses compare equal. Comparison is memcmp
+ * and hashing reads the leading bytes, which are already uniformly distributed.
+ */
+template<size_t N>
+class FixedBytes {
+public:
+    static constexpr size_t kSize = N;
+
+    constexpr FixedBytes() = default;
+
+    // Parse hex text. Throws std::invalid_argument.
+    static FixedBytes parse(std::string_view text) {
+        FixedBytes out;
+        if (!try_parse(text, out)) {
+            throw std::invalid_argument("Invalid " + std::to_string(N) + "-byte hex identifier: " + std::string(text));
+        }
+        return out;
+    }
+    // Parse hex text, returning false on malformed input
+    static bool try_parse(std::string_view text, FixedBytes& out) {
+        return decode_hex(text, out.bytes_.data(), N);
+    }
+
+    const std::array<uint8_t, N>& bytes() const { return bytes_; }
+    const uint8_t* data() const { return bytes_.data(); }
+    bool is_zero() const { return *this == FixedBytes(); }
+
+    std::string to_string() const { return encode_hex(bytes_.data(), N); }
+
+    bool operator==(const FixedBytes& other) const { return std::memcmp(data(), other.data(), N) == 0; }
+    bool operator!=(const FixedBytes& other) const { return !(*this == other); }
+    bool operator<(const FixedBytes& other) const { return std::memcmp(data(), other.data(), N) < 0; }
+
+    size_t hash() const {
+        uint64_t head;
+        uint64_t tail;
+        std::memcpy(&head, data(), 8);
+        std::memcpy(&tail, data() + N - 8, 8);
+        return static_cast<size_t>(head ^ (tail * 0x9E3779B97F4A7C15ull));
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const FixedBytes& value) { return os << value.to_string(); }
+
+private:
+    std::array<uint8_t, N> bytes_{};
+};
+
+using Hash32 = FixedBytes<32>;
+using Address20 = FixedBytes<20>;
+
+/**
+ * Unsigned 256-bit integer, used for Polymarket token IDs (up to 78 decimal digits).
+ *
+ * Stored as four little-endian 64-bit limbs. Parsing consumes eight digits per
+ * step with SWAR arithmetic instead of one multiply per digit.
+ */
+class Uint256 {
+public:
+    constexpr Uint256() = default;
+    static constexpr Uint256 from_uint64(uint64_t value) { return Uint256({value, 0, 0, 0}); }
+
+    // Parse decimal digits. Throws std::invalid_argument (malformed) or std::out_of_range (>= 2^256).
+    static Uint256 parse(std::string_view text);
+    // Parse decimal digits, returning false on malformed or out-of-range input
+    static bool try_parse(std::string_view text, Uint256& out);
+
+    // Limbs, least significant first
+    const std::array<uint64_t, 4>& limbs() const { return limbs_; }
+    bool is_zero() const { return (limbs_[0] | limbs_[1] | limbs_[2] | limbs_[3]) == 0; }
+
+    // Decimal text
+    std::string to_string() const;
+
+    bool operator==(const Uint256& other) const { return limbs_ == other.limbs_; }
+    bool operator!=(const Uint256& other) const { return limbs_ != other.limbs_; }
+    bool operator<(const Uint256& other) const {
+        for (size_t i = 4; i-- > 0;) {
+            if (limbs_[i] != other.limbs_[i]) return limbs_[i] < other.limbs_[i];
+        }
+        return false;
+    }
+
+    size_t hash() const {
+        uint64_t h = limbs_[0] ^ (limbs_[1] * 0x9E3779B97F4A7C15ull) ^ (limbs_[2] * 0xC2B2AE3D27D4EB4Full) ^ limbs_[3];
+        return static_cast<size_t>(h ^ (h >> 29));
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const Uint256& value) { return os << value.to_string(); }
+
+private:
+    constexpr explicit Uint256(std::array<uint64_t, 4> limbs) : limbs_(limbs) {}
+
+    std::array<uint64_t, 4> limbs_{};
+};
+
+}  // namespace dome
+
+namespace std {
+template<size_t N>
+struct hash<dome::FixedBytes<N>> {
+    size_t operator()(const dome::FixedBytes<N>& value) const noexcept { return value.hash(); }
+};
+
+template<>
+struct hash<dome::Uint256> {
+    size_t operator()(const dome::Uint256& value) const noexcept { return value.hash(); }
+};
+}  // namespace std
+
+#endif  // DOME_IDENTIFIERS_HPP
@@ -0,0 +1,119 @@
+#ifndef DOME_INCREMENTAL_POLLER_HPP
+#define DOME_INCREMENTAL_POLLER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "types.hpp"
+#include "orders_endpoints.hpp"
+#include "activity_endpoints.hpp"
+#include "polymarket_client.hpp"
+
+namespace dome {
+
+/**
+ * Options for IncrementalPoller.
+ *
+ * @param interval Time between background polls
+ * @param page_size Records requested per page (1-1000)
+ * @param overlap How far before the high-watermark each poll looks again, for records
+ *        the API indexes late; records seen in that window are not delivered twice
+ */
+struct IncrementalPollerOptions {
+    std::chrono::milliseconds interval{5000};
+    int page_size = 1000;
+    std::chrono::seconds overlap{0};
+};
+
+/**
+ * Polls get_orders and get_activity for new records only.
+ *
+ * Each watch keeps a high-watermark: the newest timestamp delivered and the
+ * records seen at it (orders by order_hash and tx_hash, since one order can fill
+ * in several transactions within a second; activity by tx_hash, token_id, side
+ * and shares, since it has no order hash). A poll asks only for records from the
+ * watermark on, pages through them, drops the ones already delivered and hands
+ * the rest to the watch's callback oldest first. Orders arrive as
+ * WebSocketOrderEvents with the watch ID as subscription_id, so a
+ * DomeWebSocket order callback serves as the fallback unchanged.
+ *
+ *   dome::IncrementalPoller poller(dome.polymarket);
+ *   poller.watch_orders({.user = wallet}, on_order_event);
+ *   poller.start();
+ *
+ * A failed poll leaves the watermark where it was, and a callback that throws
+ * leaves it at the last record delivered, so the next poll catches up.
+ * All methods are thread-safe; callbacks run on the polling thread.
+ */
+class IncrementalPoller {
+public:
+    using OrderEventCallback = dome::OrderEventCallback;
+    using ActivityCallback = std::function<void(const Activity&)>;
+    using ErrorCallback = std::function<void(const std::string& watch_id, const DomeAPIError&)>;
+
+    IncrementalPoller(OrdersEndpoints& orders, ActivityEndpoints& activity, IncrementalPollerOptions options = {});
+    explicit IncrementalPoller(PolymarketClient& polymarket, IncrementalPollerOptions options = {});
+    ~IncrementalPoller();
+
+    IncrementalPoller(const IncrementalPoller&) = delete;
+    IncrementalPoller& operator=(const IncrementalPoller&) = delete;
+
+    // Deliver orders matching filter (its time range, limit and offset are managed by
+    // the poller) from since on; without since, orders from now on. Returns the watch ID.
+    std::string watch_orders(const GetOrdersParams& filter, OrderEventCallback callback,
+                             std::optional<int64_t> since = std::nullopt);
+
+    // Deliver activity matching filter, as watch_orders
+    std::string watch_activity(const GetActivityParams& filter, ActivityCallback callback,
+                               std::optional<int64_t> since = std::nullopt);
+
+    // Stop a watch; a poll already running may still deliver one batch for it
+    bool unwatch(const std::string& watch_id);
+
+    // Poll every watch once on this thread and return the records delivered. Errors
+    // go to the error callback; without one, the first is thrown after all watches ran.
+    size_t poll();
+
+    // Poll every interval on a background thread until stopped
+    void start();
+    void stop();
+
+    void set_error_callback(ErrorCallback callback);
+
+    // Newest timestamp delivered (or the starting point) of a watch
+    std::optional<int64_t> watermark(const std::string& watch_id) const;
+
+private:
+    struct Watch;
+
+    std::string add(std::shared_ptr<Watch> watch);
+    size_t poll_watch(Watch& watch);
+    void poll_loop();
+
+    OrdersEndpoints& orders_;
+    ActivityEndpoints& activity_;
+    IncrementalPollerOptions options_;
+
+    mutable std::mutex mutex_;  // guards watches_, next_id_ and error_callback_
+    std::map<std::string, std::shared_ptr<Watch>> watches_;
+    uint64_t next_id_ = 1;
+    ErrorCallback error_callback_;
+
+    std::mutex poll_mutex_;  // serializes polls and guards the watermarks
+
+    std::thread poll_thread_;
+    std::mutex thread_mutex_;
+    std::condition_variable stop_cv_;
+    bool stopping_ = false;
+};
+
+}  // namespace dome
+
+#endif  // DOME_INCREMENTAL_POLLER_HPP
@@ -0,0 +1,112 @@
+#ifndef DOME_INTERN_HPP
+#define DOME_INTERN_HPP
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <ostream>
+#include <shared_mutex>
+#include <unordered_map>
+#include <functional>
+
+namespace dome {
+
+/**
+ * Immutable string used for identifiers that repeat across records (market
+ * slugs, condition IDs, titles, token IDs, outcome labels).
+ *
+ * Built from a plain string, it holds its own std::string, so short values need
+ * no allocation and copies copy it. When records are decoded through an
+ * InternTable, it references the table's reference-counted buffer instead, and
+ * every record referring to the same market shares that buffer.
+ * Converts implicitly to const std::string&.
+ */
+class InternedString {
+public:
+    InternedString() = default;
+    InternedString(std::string value) : local_(std::move(value)) {}
+    InternedString(const char* value) : local_(value) {}
+    explicit InternedString(std::shared_ptr<const std::string> value) : shared_(std::move(value)) {}
+
+    const std::string& str() const { return shared_ ? *shared_ : local_; }
+    operator const std::string&() const { return str(); }
+
+    const char* c_str() const { return str().c_str(); }
+    size_t size() const { return str().size(); }
+    size_t length() const { return str().size(); }
+    bool empty() const { return str().empty(); }
+    std::string substr(size_t pos = 0, size_t count = std::string::npos) const {
+        return str().substr(pos, count);
+    }
+
+    // True if both strings point at the same interned buffer
+    bool shares_storage_with(const InternedString& other) const {
+        return shared_ && shared_ == other.shared_;
+    }
+
+    friend bool operator==(const InternedString& a, const InternedString& b) {
+        return a.shares_storage_with(b) || a.str() == b.str();
+    }
+    friend bool operator!=(const InternedString& a, const InternedString& b) { return !(a == b); }
+    friend bool operator<(const InternedString& a, const InternedString& b) { return a.str() < b.str(); }
+    friend bool operator==(const InternedString& a, const std::string& b) { return a.str() == b; }
+    friend bool operator==(const std::string& a, const InternedString& b) { return a == b.str(); }
+    friend bool operator!=(const InternedString& a, const std::string& b) { return a.str() != b; }
+    friend bool operator!=(const std::string& a, const InternedString& b) { return a != b.str(); }
+    friend bool operator==(const InternedString& a, const char* b) { return a.str() == b; }
+    friend bool operator==(const char* a, const InternedString& b) { return a == b.str(); }
+    friend bool operator!=(const InternedString& a, const char* b) { return a.str() != b; }
+    friend bool operator!=(const char* a, const InternedString& b) { return a != b.str(); }
+    friend std::string operator+(const std::string& a, const InternedString& b) { return a + b.str(); }
+    friend std::string operator+(const InternedString& a, const std::string& b) { return a.str() + b; }
+
+    friend std::ostream& operator<<(std::ostream& os, const InternedString& s) { return os << s.str(); }
+
+private:
+    std::string local_;                          // without an intern table
+    std::shared_ptr<const std::string> shared_;  // the table's buffer; takes precedence
+};
+
+/**
+ * Thread-safe table of interned identifier strings.
+ *
+ * Share one table between endpoints (DomeSDKConfig::intern_table) and
+ * DomeWebSocket (set_intern_table) so decoded records reference a single copy
+ * of each identifier. Lookups of already-interned values take a shared lock
+ * and do not allocate.
+ */
+class InternTable {
+public:
+    InternTable() = default;
+    InternTable(const InternTable&) = delete;
+    InternTable& operator=(const InternTable&) = delete;
+
+    // Return the shared instance of value, inserting it if needed
+    InternedString intern(std::string_view value);
+
+    // Drop entries that are no longer referenced by any record. Returns the number removed.
+    size_t prune();
+
+    // Drop all entries. Records keep their strings alive.
+    void clear();
+
+    size_t size() const;
+
+private:
+    mutable std::shared_mutex mutex_;
+    // Keys view the shared string they map to, so each identifier is stored once
+    std::unordered_map<std::string_view, std::shared_ptr<const std::string>> entries_;
+};
+
+}  // namespace dome
+
+namespace std {
+template<>
+struct hash<dome::InternedString> {
+    size_t operator()(const dome::InternedString& s) const noexcept {
+        return std::hash<std::string>{}(s.str());
+    }
+};
+}  // namespace std
+
+#endif  // DOME_INTERN_HPP
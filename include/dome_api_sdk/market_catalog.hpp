@@ -0,0 +1,151 @@
+#ifndef DOME_MARKET_CATALOG_HPP
+#define DOME_MARKET_CATALOG_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <functional>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#include "types.hpp"
+#include "market_endpoints.hpp"
+#include "token_index.hpp"
+
+namespace dome {
+
+/**
+ * Options for MarketCatalog.
+ *
+ * @param filter Base filter for the markets to load (e.g. tags or min_volume); limit and offset are managed by the catalog
+ * @param page_size Markets requested per page (1-100)
+ * @param refresh_interval Time between background refreshes
+ */
+struct MarketCatalogOptions {
+    GetMarketsParams filter;
+    int page_size = 100;
+    std::chrono::seconds refresh_interval{300};
+};
+
+/**
+ * Immutable, fully indexed view of the catalog at one point in time.
+ *
+ * Lookups by slug, condition ID and token ID are O(1) hash lookups; tag and
+ * status lookups return precomputed lists. Pointers stay valid for as long as
+ * the snapshot is held. Not copyable or movable: the tag and status lists point
+ * into the snapshot's own markets.
+ */
+class MarketCatalogSnapshot {
+public:
+    MarketCatalogSnapshot() = default;
+    MarketCatalogSnapshot(const MarketCatalogSnapshot&) = delete;
+    MarketCatalogSnapshot& operator=(const MarketCatalogSnapshot&) = delete;
+
+    const Market* by_slug(const std::string& market_slug) const;
+    const Market* by_condition_id(const std::string& condition_id) const;
+
+    // Market whose side_a or side_b has this token ID; side is set to that side
+    const Market* by_token_id(const std::string& token_id, const MarketSide** side = nullptr) const;
+
+    const std::vector<const Market*>& with_tag(const std::string& tag) const;
+    const std::vector<const Market*>& with_status(const std::string& status) const;
+
+    const std::vector<Market>& markets() const { return tokens_.markets(); }
+    const TokenIndex& tokens() const { return tokens_; }
+    size_t size() const { return tokens_.markets().size(); }
+    std::chrono::system_clock::time_point loaded_at() const { return loaded_at_; }
+
+private:
+    friend class MarketCatalog;
+
+    // Build the slug, condition, tag and status indexes over tokens_.markets()
+    void index();
+
+    TokenIndex tokens_;
+    std::unordered_map<std::string, size_t> by_slug_;
+    std::unordered_map<std::string, size_t> by_condition_id_;
+    std::unordered_map<std::string, std::vector<const Market*>> by_tag_;
+    std::unordered_map<std::string, std::vector<const Market*>> by_status_;
+    std::chrono::system_clock::time_point loaded_at_;
+};
+
+/**
+ * Local, indexed copy of Polymarket market metadata.
+ *
+ * load() pages through get_markets once. refresh() then only re-reads open
+ * markets, upserts them, and re-fetches by slug, a page of slugs per request,
+ * any market that dropped out of the open set so its status and winning side
+ * are current. A market the lookup does not return gets status "unknown" and is
+ * not looked up again. A failed page is retried one slug at a time; a market
+ * whose lookup still fails stays as it was for the next refresh, the rest is
+ * published, and refresh() then throws the first lookup error. Each load/refresh
+ * builds a new snapshot off to the side and publishes it atomically, so readers
+ * never block and never see a half-built index.
+ *
+ *   dome::MarketCatalog catalog(dome.polymarket.markets);
+ *   catalog.load();
+ *   catalog.start_auto_refresh();
+ *   auto market = catalog.find_by_token_id(event.data.token_id);
+ *
+ * All methods are thread-safe.
+ */
+class MarketCatalog {
+public:
+    using RefreshErrorCallback = std::function<void(const DomeAPIError&)>;
+
+    explicit MarketCatalog(MarketEndpoints& endpoints, MarketCatalogOptions options = {});
+    ~MarketCatalog();
+
+    MarketCatalog(const MarketCatalog&) = delete;
+    MarketCatalog& operator=(const MarketCatalog&) = delete;
+
+    // Fetch every market matching the filter and replace the catalog
+    void load();
+
+    // Re-read open markets and update changed ones (performs a full load if nothing is loaded yet)
+    void refresh();
+
+    // Refresh every refresh_interval on a background thread until stopped
+    void start_auto_refresh();
+    void stop_auto_refresh();
+
+    // Errors thrown by background refreshes, other exceptions wrapped as DomeAPIError(-1).
+    // A failed refresh keeps the previous snapshot unless only market lookups failed.
+    void set_refresh_error_callback(RefreshErrorCallback callback);
+
+    // Current snapshot (never null; empty before the first load)
+    std::shared_ptr<const MarketCatalogSnapshot> snapshot() const;
+
+    std::optional<Market> find_by_slug(const std::string& market_slug) const;
+    std::optional<Market> find_by_condition_id(const std::string& condition_id) const;
+    std::optional<Market> find_by_token_id(const std::string& token_id) const;
+    size_t size() const { return snapshot()->size(); }
+
+    // Token index of the current snapshot, e.g. for DomeWebSocket::set_token_index.
+    // Keeps that snapshot alive; fetch it again after a refresh to see new markets.
+    std::shared_ptr<const TokenIndex> token_index() const;
+
+private:
+    std::vector<Market> fetch_all(GetMarketsParams params);
+    void publish(std::vector<Market> markets);
+    void refresh_loop();
+
+    MarketEndpoints& endpoints_;
+    MarketCatalogOptions options_;
+    std::shared_ptr<const MarketCatalogSnapshot> snapshot_;
+    std::mutex refresh_mutex_;  // serializes load/refresh
+
+    RefreshErrorCallback error_callback_;
+    std::thread refresh_thread_;
+    std::mutex thread_mutex_;
+    std::condition_variable stop_cv_;
+    bool stopping_ = false;
+};
+
+}  // namespace dome
+
+#endif  // DOME_MARKET_CATALOG_HPP
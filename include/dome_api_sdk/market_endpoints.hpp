@@ -4,27 +4,72 @@
 #include "base_endpoint.hpp"
 #include "types.hpp"
 
+#include <functional>
+
 namespace dome {
 
+/**
+ * Reusable get_market_price for hot polling loops.
+ *
+ * Keeps one curl handle, header list and URL prefix, so each call only formats
+ * the token ID and at_time. Not thread-safe: use one per thread.
+ */
+class PreparedMarketPrice {
+public:
+    explicit PreparedMarketPrice(PreparedRequest request) : request_(std::move(request)) {}
+
+    MarketPriceResponse get(const GetMarketPriceParams& params, const RequestConfig& request_config = {});
+
+private:
+    PreparedRequest request_;
+};
+
 class MarketEndpoints : public BaseEndpoint {
 public:
     explicit MarketEndpoints(const DomeSDKConfig& config);
 
     // Get current or historical market price
     // Endpoint: /polymarket/market-price/{token_id}
-    MarketPriceResponse get_market_price(const GetMarketPriceParams& params);
+    MarketPriceResponse get_market_price(const GetMarketPriceParams& params, const RequestConfig& request_config = {});
+    AsyncOp<MarketPriceResponse> get_market_price_async(AsyncLoop& loop, const GetMarketPriceParams& params,
+                                                        const RequestConfig& request_config = {});
+
+    // Prepare a reusable get_market_price request (see PreparedMarketPrice)
+    PreparedMarketPrice prepare_market_price() const;
 
     // Get historical candlestick data
     // Endpoint: /polymarket/candlesticks/{condition_id}
-    CandlesticksResponse get_candlesticks(const GetCandlesticksParams& params);
+    CandlesticksResponse get_candlesticks(const GetCandlesticksParams& params, const RequestConfig& request_config = {});
+    AsyncOp<CandlesticksResponse> get_candlesticks_async(AsyncLoop& loop, const GetCandlesticksParams& params,
+                                                         const RequestConfig& request_config = {});
 
     // Get markets with filtering
     // Endpoint: /polymarket/markets
-    MarketsResponse get_markets(const GetMarketsParams& params = {});
+    MarketsResponse get_markets(const GetMarketsParams& params = {}, const RequestConfig& request_config = {});
+    AsyncOp<MarketsResponse> get_markets_async(AsyncLoop& loop, const GetMarketsParams& params = {},
+                                               const RequestConfig& request_config = {});
 
     // Get historical orderbook snapshots
     // Endpoint: /polymarket/orderbooks
-    OrderbooksResponse get_orderbooks(const GetOrderbooksParams& params);
+    OrderbooksResponse get_orderbooks(const GetOrderbooksParams& params, const RequestConfig& request_config = {});
+    AsyncOp<OrderbooksResponse> get_orderbooks_async(AsyncLoop& loop, const GetOrderbooksParams& params,
+                                                     const RequestConfig& request_config = {});
+
+    // Get orderbook snapshots, decoding each one while the page is still downloading.
+    // on_snapshot is called once per snapshot in response order; returns the page's pagination.
+    OrderbookPagination stream_orderbooks(const GetOrderbooksParams& params,
+                                          const std::function<void(const OrderbookSnapshot&)>& on_snapshot,
+                                          const RequestConfig& request_config = {});
+
+private:
+    BatchRequest make_market_price_request(const GetMarketPriceParams& params);
+    BatchRequest make_candlesticks_request(const GetCandlesticksParams& params);
+    BatchRequest make_markets_request(const GetMarketsParams& params);
+    std::map<std::string, std::string> build_orderbooks_query(const GetOrderbooksParams& params);
+
+    static CandlesticksResponse parse_candlesticks(const nlohmann::json& json);
+    static MarketsResponse parse_markets(const nlohmann::json& json);
+    static OrderbooksResponse parse_orderbooks(const nlohmann::json& json);
 };
 
 }  // namespace dome
@@ -0,0 +1,127 @@
+#ifndef DOME_ORDER_BOOK_HPP
+#define DOME_ORDER_BOOK_HPP
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <functional>
+#include <unordered_map>
+
+#include "types.hpp"
+
+namespace dome {
+
+enum class BookSide {
+    BID,
+    ASK
+};
+
+/**
+ * Local order book for one token.
+ *
+ * Each side is a contiguous array of price levels sorted best-first (bids
+ * descending, asks ascending) with running size and notional totals, so
+ * depth-at-price, cumulative depth and VWAP-to-size are binary searches.
+ * Running totals are kept up to date by load and set_level (from the changed
+ * level onward), so const queries only read and may run concurrently with each
+ * other. Loading a snapshot reuses the existing buffers, so replaying snapshots
+ * does not allocate once the book has reached its working size. Modifying it
+ * while another thread queries it is not safe.
+ */
+class OrderBook {
+public:
+    OrderBook() = default;
+
+    // Replace the book with the contents of a snapshot. Levels are sorted,
+    // duplicate prices merged and empty levels dropped.
+    void load(const OrderbookSnapshot& snapshot);
+
+    // Set the resting size at a price. A zero size removes the level. O(n) worst case.
+    void set_level(BookSide side, Decimal price, Decimal size);
+
+    // Remove all levels
+    void clear();
+
+    std::optional<OrderbookLevel> best_bid() const;
+    std::optional<OrderbookLevel> best_ask() const;
+    std::optional<Decimal> mid_price() const;
+    std::optional<Decimal> spread() const;
+
+    // Size resting at exactly this price (zero if no level). O(log n).
+    Decimal depth_at(BookSide side, Decimal price) const;
+
+    // Total size at prices at or better than limit_price. O(log n).
+    Decimal cumulative_depth(BookSide side, Decimal limit_price) const;
+
+    // Average price to fill size against this side (taking asks to buy, bids to sell).
+    // Returns nullopt if the side does not hold enough size. O(log n).
+    std::optional<Decimal> vwap(BookSide side, Decimal size) const;
+
+    // Total size resting on a side
+    Decimal total_depth(BookSide side) const;
+
+    // Levels best-first
+    const std::vector<OrderbookLevel>& levels(BookSide side) const;
+    const std::vector<OrderbookLevel>& bids() const { return bids_.levels; }
+    const std::vector<OrderbookLevel>& asks() const { return asks_.levels; }
+
+    const std::string& asset_id() const { return asset_id_; }
+    const std::string& hash() const { return hash_; }
+    int64_t timestamp() const { return timestamp_; }
+    Decimal tick_size() const { return tick_size_; }
+    bool empty() const { return bids_.levels.empty() && asks_.levels.empty(); }
+
+private:
+    struct Side {
+        std::vector<OrderbookLevel> levels;
+        // cumulative_size[i] / cumulative_notional[i] cover levels[0..i]
+        std::vector<Decimal> cumulative_size;
+        std::vector<Decimal> cumulative_notional;
+    };
+
+    Side& side_of(BookSide side) { return side == BookSide::BID ? bids_ : asks_; }
+    const Side& side_of(BookSide side) const { return side == BookSide::BID ? bids_ : asks_; }
+
+    static void load_side(Side& side, const std::vector<OrderbookLevel>& levels, bool descending);
+    // Recompute running totals from level from onward
+    static void update_totals(Side& side, size_t from);
+    // Index of the first level not better than price
+    static size_t lower_bound(const Side& side, Decimal price, bool descending);
+
+    Side bids_;
+    Side asks_;
+    std::string asset_id_;
+    std::string hash_;
+    int64_t timestamp_ = 0;
+    Decimal tick_size_;
+};
+
+/**
+ * Maintains one OrderBook per token from a stream of orderbook snapshots.
+ *
+ * Snapshots older than the book's current timestamp are ignored, so pages can
+ * be replayed in any order of arrival without rewinding a book.
+ */
+class OrderBookEngine {
+public:
+    using BookCallback = std::function<void(const OrderBook&)>;
+
+    // Apply one snapshot to the book for its assetId and return that book
+    const OrderBook& ingest(const OrderbookSnapshot& snapshot);
+
+    // Apply a page of snapshots in order, invoking on_update after each one
+    void ingest(const OrderbooksResponse& response, const BookCallback& on_update = {});
+
+    // Book for a token, or nullptr if no snapshot has been seen for it
+    const OrderBook* book(const std::string& asset_id) const;
+
+    size_t size() const { return books_.size(); }
+    void clear() { books_.clear(); }
+
+private:
+    std::unordered_map<std::string, OrderBook> books_;
+};
+
+}  // namespace dome
+
+#endif  // DOME_ORDER_BOOK_HPP
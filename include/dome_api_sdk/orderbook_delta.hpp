@@ -0,0 +1,128 @@
+#ifndef DOME_ORDERBOOK_DELTA_HPP
+#define DOME_ORDERBOOK_DELTA_HPP
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <functional>
+#include <unordered_map>
+
+#include "types.hpp"
+#include "order_book.hpp"
+
+namespace dome {
+
+/**
+ * Change to one price level. A zero size removes the level.
+ *
+ * @param side Book side of the level
+ * @param price Level price
+ * @param size New resting size (zero = removed)
+ */
+struct OrderbookLevelChange {
+    BookSide side;
+    Decimal price;
+    Decimal size;
+};
+
+/**
+ * Incremental update between consecutive snapshots of one asset.
+ *
+ * The first delta for an asset carries the whole book as additions. Metadata
+ * fields are only set when they differ from the previous snapshot.
+ *
+ * @param asset_id Asset ID
+ * @param timestamp Timestamp of the snapshot in milliseconds
+ * @param indexed_at When the snapshot was indexed in milliseconds
+ * @param hash Snapshot hash
+ * @param changes Changed levels, bids then asks, each in ascending price order
+ * @param tick_size Tick size (set when changed)
+ * @param min_order_size Minimum order size (set when changed)
+ * @param neg_risk Negative risk flag (set when changed)
+ * @param market Market identifier (set when changed)
+ */
+struct OrderbookDelta {
+    std::string asset_id;
+    int64_t timestamp = 0;
+    int64_t indexed_at = 0;
+    std::string hash;
+    std::vector<OrderbookLevelChange> changes;
+    std::optional<Decimal> tick_size;
+    std::optional<Decimal> min_order_size;
+    std::optional<bool> neg_risk;
+    std::optional<std::string> market;
+};
+
+/**
+ * Encoder statistics.
+ *
+ * @param snapshots Snapshots seen
+ * @param skipped Snapshots dropped because their hash matched the previous one
+ * @param levels_in Levels contained in the snapshots seen
+ * @param levels_out Level changes emitted
+ */
+struct OrderbookDeltaStats {
+    size_t snapshots = 0;
+    size_t skipped = 0;
+    size_t levels_in = 0;
+    size_t levels_out = 0;
+};
+
+/**
+ * Turns successive OrderbookSnapshots into per-asset deltas.
+ */
+class OrderbookDeltaEncoder {
+public:
+    using DeltaCallback = std::function<void(const OrderbookDelta&)>;
+
+    // Delta from the previous snapshot of the same asset, or nullopt if the
+    // snapshot's hash matches the previous one
+    std::optional<OrderbookDelta> encode(const OrderbookSnapshot& snapshot);
+
+    // Encode a page of snapshots in order
+    void encode(const OrderbooksResponse& response, const DeltaCallback& on_delta);
+
+    const OrderbookDeltaStats& stats() const { return stats_; }
+
+    // Forget all previous snapshots; the next delta per asset is a full book again
+    void reset();
+
+private:
+    struct State {
+        std::string hash;
+        std::vector<OrderbookLevel> bids;  // ascending price
+        std::vector<OrderbookLevel> asks;  // ascending price
+        Decimal tick_size;
+        Decimal min_order_size;
+        bool neg_risk = false;
+        std::string market;
+    };
+
+    std::unordered_map<std::string, State> previous_;
+    std::vector<OrderbookLevel> scratch_;
+    OrderbookDeltaStats stats_;
+};
+
+/**
+ * Rebuilds snapshots from deltas produced by OrderbookDeltaEncoder.
+ *
+ * Decoded snapshots list both sides in ascending price order.
+ */
+class OrderbookDeltaDecoder {
+public:
+    // Apply a delta and return the reconstructed snapshot for its asset
+    const OrderbookSnapshot& decode(const OrderbookDelta& delta);
+
+    // Current snapshot for an asset, or nullptr if no delta has been seen for it
+    const OrderbookSnapshot* snapshot(const std::string& asset_id) const;
+
+    void reset() { books_.clear(); }
+
+private:
+    std::unordered_map<std::string, OrderbookSnapshot> books_;
+    std::vector<OrderbookLevel> scratch_;
+};
+
+}  // namespace dome
+
+#endif  // DOME_ORDERBOOK_DELTA_HPP
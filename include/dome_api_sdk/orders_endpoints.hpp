@@ -1,9 +1,12 @@
 #ifndef DOME_ORDERS_ENDPOINTS_HPP
 #define DOME_ORDERS_ENDPOINTS_HPP
 
+#include "arena.hpp"
 #include "base_endpoint.hpp"
 #include "types.hpp"
 
+#include <functional>
+
 namespace dome {
 
 class OrdersEndpoints : public BaseEndpoint {
@@ -12,7 +15,25 @@ public:
 
     // Get orders with filtering
     // Endpoint: /polymarket/orders
-    OrdersResponse get_orders(const GetOrdersParams& params = {});
+    OrdersResponse get_orders(const GetOrdersParams& params = {}, const RequestConfig& request_config = {});
+    AsyncOp<OrdersResponse> get_orders_async(AsyncLoop& loop, const GetOrdersParams& params = {},
+                                             const RequestConfig& request_config = {});
+
+    // Get orders, decoding each one while the page is still downloading.
+    // on_order is called once per order in response order; returns the page's pagination.
+    Pagination stream_orders(const GetOrdersParams& params,
+                             const std::function<void(const Order&)>& on_order,
+                             const RequestConfig& request_config = {});
+
+    // Get orders into page, replacing what it held: the records and their strings are
+    // decoded straight into the page's arena while the response downloads
+    void get_orders_into(const GetOrdersParams& params, OrdersArenaPage& page,
+                         const RequestConfig& request_config = {});
+
+private:
+    std::map<std::string, std::string> build_query(const GetOrdersParams& params);
+    // Static, and given the intern table, so that async completions never touch the endpoint
+    static OrdersResponse parse_orders(const nlohmann::json& json, InternTable* intern_table);
 };
 
 }  // namespace dome
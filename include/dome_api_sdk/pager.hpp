@@ -0,0 +1,56 @@
+#ifndef DOME_PAGER_HPP
+#define DOME_PAGER_HPP
+
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace dome {
+
+/**
+ * Walk an offset-paginated endpoint page by page.
+ *
+ * Starts at params.offset (0 when unset) and asks for page_size records per page,
+ * advancing the offset by the records each page returned, until a page reports
+ * no more or comes back empty. fetch(params) returns one page, records names its
+ * record array (e.g. &OrdersResponse::orders), and on_page receives that array
+ * as an rvalue, so records can be moved out of it.
+ *
+ *   for_each_page(params, 1000, [&](const GetOrdersParams& p) { return orders.get_orders(p); },
+ *                 &OrdersResponse::orders, [&](std::vector<Order>&& page) { ... });
+ */
+template<typename Params, typename Fetch, typename Page, typename Record, typename OnPage>
+void for_each_page(Params params, int page_size, Fetch&& fetch, std::vector<Record> Page::*records,
+                   OnPage&& on_page) {
+    int offset = params.offset.value_or(0);
+    params.limit = page_size;
+    while (true) {
+        params.offset = offset;
+        Page page = fetch(params);
+        std::vector<Record>& items = page.*records;
+        const size_t count = items.size();
+        on_page(std::move(items));
+
+        offset += static_cast<int>(count);
+        if (!page.pagination.has_more || count == 0) {
+            break;
+        }
+    }
+}
+
+// Every record of every page, in order (see for_each_page)
+template<typename Params, typename Fetch, typename Page, typename Record>
+std::vector<Record> fetch_all_pages(Params params, int page_size, Fetch&& fetch,
+                                    std::vector<Record> Page::*records) {
+    std::vector<Record> all;
+    for_each_page(std::move(params), page_size, std::forward<Fetch>(fetch), records,
+                  [&all](std::vector<Record>&& page) {
+                      all.insert(all.end(), std::make_move_iterator(page.begin()),
+                                 std::make_move_iterator(page.end()));
+                  });
+    return all;
+}
+
+}  // namespace dome
+
+#endif  // DOME_PAGER_HPP
@@ -0,0 +1,163 @@
+#ifndef DOME_PNL_ENGINE_HPP
+#define DOME_PNL_ENGINE_HPP
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <mutex>
+
+#include "types.hpp"
+#include "identifiers.hpp"
+
+namespace dome {
+
+/**
+ * Position in one token held by one wallet.
+ *
+ * @param token_id Token ID
+ * @param condition_id Condition ID of the token's market
+ * @param shares Shares currently held (normalized)
+ * @param cost_basis Cost of the shares currently held (average cost * shares)
+ * @param realized_pnl PnL booked by sells, merges and redemptions
+ * @param unmatched_shares Shares sold beyond the known position (history started mid-position); no PnL is booked for them
+ * @param mark_price Latest price seen for the token, if any
+ * @param last_update Timestamp of the last event applied to the position
+ */
+struct Position {
+    std::string token_id;
+    std::string condition_id;
+    Decimal shares;
+    Decimal cost_basis;
+    Decimal realized_pnl;
+    Decimal unmatched_shares;
+    std::optional<Decimal> mark_price;
+    int64_t last_update = 0;
+
+    // Average cost per share held (zero when flat)
+    Decimal average_cost() const { return shares > Decimal() ? cost_basis / shares : Decimal(); }
+
+    // Mark-to-market value of the shares held (zero when unmarked)
+    Decimal market_value() const { return mark_price ? shares * *mark_price : Decimal(); }
+
+    // Market value minus cost basis (zero when unmarked)
+    Decimal unrealized_pnl() const { return mark_price ? market_value() - cost_basis : Decimal(); }
+};
+
+/**
+ * PnL totals for one wallet.
+ *
+ * @param wallet_address Wallet address (lowercase hex)
+ * @param realized_pnl Sum of realized PnL over all positions
+ * @param unrealized_pnl Sum of unrealized PnL over marked positions
+ * @param cost_basis Cost of all shares held
+ * @param market_value Mark-to-market value of all marked positions
+ * @param open_positions Positions with shares held
+ */
+struct WalletPnL {
+    std::string wallet_address;
+    Decimal realized_pnl;
+    Decimal unrealized_pnl;
+    Decimal cost_basis;
+    Decimal market_value;
+    size_t open_positions = 0;
+
+    Decimal total_pnl() const { return realized_pnl + unrealized_pnl; }
+};
+
+/**
+ * Incremental per-wallet, per-token position and PnL tracker.
+ *
+ * Uses average-cost accounting. BUY fills add shares at the fill price and SELL
+ * fills realize (price - average cost) on the shares sold. REDEEM disposes of
+ * shares at the activity price (the payout per share). SPLIT turns $1 into one
+ * share of each outcome and MERGE turns one of each back into $1, so both touch
+ * the two outcome tokens of the condition, priced in proportion to their marks
+ * (half each when either is unmarked) so the pair costs or returns exactly $1.
+ * That needs the condition's tokens: register them with set_outcomes() from
+ * get_markets; SPLIT and MERGE for unregistered conditions are left out. Every
+ * fill also marks its token, and mark() can be fed from order books or candles.
+ *
+ * Each event touches one position (two for SPLIT and MERGE), so updates are O(1); wallet totals are
+ * summed over the wallet's positions when queried. Orders are attributed to
+ * Order::user. Wallets and tokens are keyed by their binary form (Address20,
+ * Uint256), so address case does not matter and events whose user or token_id
+ * do not parse are ignored. Duplicate events are not detected, so feed each fill once
+ * (e.g. seed from history up to the time the WebSocket subscription started).
+ *
+ *   dome::PnLEngine pnl;
+ *   pnl.track("0xwallet...");
+ *   ws.set_order_event_callback([&](const WebSocketOrderEvent& e) { pnl.on_order_event(e); });
+ *   auto totals = pnl.wallet_pnl("0xwallet...");
+ *
+ * All methods are thread-safe.
+ */
+class PnLEngine {
+public:
+    // Only apply events for this wallet. With no tracked wallets every wallet is tracked.
+    // Throws std::invalid_argument if the address is not 0x + 40 hex digits.
+    void track(const std::string& wallet_address);
+    void untrack(const std::string& wallet_address);
+
+    void on_order(const Order& order);
+    void on_order_event(const WebSocketOrderEvent& event);
+    void on_activity(const Activity& activity);
+
+    // Register the two outcome tokens of a market's condition, needed to apply SPLIT
+    // and MERGE. Markets without both side IDs are ignored.
+    void set_outcomes(const Market& market);
+    void set_outcomes(const MarketsResponse& markets);
+
+    // Seed from historical pages; records are applied oldest first
+    void seed(const OrdersResponse& orders);
+    void seed(const ActivityResponse& activity);
+
+    // Set the mark price for a token across all wallets
+    void mark(const std::string& token_id, Decimal price);
+
+    std::optional<Position> position(const std::string& wallet_address, const std::string& token_id) const;
+
+    // All positions of a wallet, including closed ones that realized PnL
+    std::vector<Position> positions(const std::string& wallet_address) const;
+
+    WalletPnL wallet_pnl(const std::string& wallet_address) const;
+
+    // Wallets that have at least one position
+    std::vector<std::string> wallets() const;
+
+    // Drop all positions and marks; tracked wallets and registered outcomes stay
+    void clear();
+
+private:
+    struct Wallet {
+        std::unordered_map<Uint256, Position> positions;
+    };
+
+    // The two outcome tokens of a condition
+    struct Outcomes {
+        Uint256 tokens[2];
+        std::string token_ids[2];
+    };
+
+    bool is_tracked(const Address20& wallet) const;
+    const Outcomes* outcomes_for(const std::string& condition_id, const Uint256* token) const;
+    void apply_pair(const Address20& wallet, const Outcomes& outcomes, const Activity& activity);
+    Position& position_for(const Address20& wallet, const Uint256& token, const std::string& token_id,
+                           const std::string& condition_id);
+    Position with_mark(const Uint256& token, const Position& position) const;
+
+    static void acquire(Position& position, Decimal shares, Decimal price);
+    static void dispose(Position& position, Decimal shares, Decimal price);
+
+    std::unordered_map<Address20, Wallet> wallets_;
+    std::unordered_map<Uint256, Decimal> marks_;
+    std::unordered_set<Address20> tracked_;
+    std::unordered_map<Hash32, Outcomes> outcomes_;      // by condition ID
+    std::unordered_map<Uint256, Hash32> conditions_;     // outcome token -> condition ID
+    mutable std::mutex mutex_;
+};
+
+}  // namespace dome
+
+#endif  // DOME_PNL_ENGINE_HPP
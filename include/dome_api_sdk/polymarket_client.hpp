@@ -14,6 +14,10 @@
 namespace dome {
 
 class PolymarketClient {
+private:
+    // Declared first so the endpoints are built from it, sharing its connection pool
+    DomeSDKConfig config_;
+
 public:
     // Constructor with configuration
     explicit PolymarketClient(const DomeSDKConfig& config);
@@ -24,12 +28,18 @@ public:
     WalletEndpoints wallet;
     ActivityEndpoints activity;
 
+    // Resolve the API host and open connections ahead of the first request.
+    // Returns how many connections are warm.
+    size_t warmup(size_t connections = 4);
+
+    const std::shared_ptr<ConnectionPool>& connection_pool() const { return config_.connection_pool; }
 
 private:
-    DomeSDKConfig config_;
-    
     // Resolve API key from config or environment
     static std::string resolve_api_key(const DomeSDKConfig& config);
+
+    // Config with a connection pool to share between the endpoints
+    static DomeSDKConfig with_connection_pool(const DomeSDKConfig& config);
 };
 
 }  // namespace dome
@@ -0,0 +1,123 @@
+#ifndef DOME_REQUEST_SCHEDULER_HPP
+#define DOME_REQUEST_SCHEDULER_HPP
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "types.hpp"
+
+namespace dome {
+
+/**
+ * Options for RequestScheduler.
+ *
+ * @param max_in_flight Requests running at once, across all priorities
+ * @param max_bulk_in_flight How many of those may be BULK, so bulk traffic always
+ *        leaves slots free for interactive requests
+ * @param adaptive Move the limit between min_in_flight and max_in_flight from the
+ *        outcomes reported through Permit::report (AIMD)
+ * @param min_in_flight Lowest adaptive limit
+ * @param latency_tolerance Responses slower than this multiple of the baseline
+ *        latency count as congestion
+ * @param backoff Factor the adaptive limit is multiplied by on congestion
+ */
+struct SchedulerOptions {
+    size_t max_in_flight = 16;
+    size_t max_bulk_in_flight = 8;
+    bool adaptive = false;
+    size_t min_in_flight = 1;
+    double latency_tolerance = 2.0;
+    double backoff = 0.7;
+};
+
+/**
+ * Admission control for requests by priority and deadline.
+ *
+ * A request holds a Permit while it runs. When all slots are busy, waiting
+ * requests are started strictly by priority (INTERACTIVE, NORMAL, BULK) and in
+ * arrival order within a priority, and BULK requests never take more than
+ * max_bulk_in_flight slots. A request whose deadline passes while it waits is
+ * shed with a DomeAPIError instead of being started; a blocked acquire() also
+ * gives up when the request is cancelled. Share one scheduler
+ * between clients through DomeSDKConfig::scheduler. Thread-safe.
+ *
+ * With SchedulerOptions::adaptive the limit follows the server: it grows by one
+ * per limit's worth of fast successes while it is in use, and is cut by the
+ * backoff factor, at most once per round trip, on 429 and 5xx responses,
+ * timeouts, transport failures and responses much slower than the baseline
+ * (the lowest recent latency). The BULK share shrinks with it.
+ */
+class RequestScheduler {
+    struct State;
+
+public:
+    // A running slot; released on destruction
+    class Permit {
+    public:
+        Permit() = default;
+        Permit(Permit&& other) noexcept;
+        Permit& operator=(Permit&& other) noexcept;
+        ~Permit();
+
+        explicit operator bool() const { return state_ != nullptr; }
+
+        // Feed the request's outcome and its latency since the permit was granted
+        // to the adaptive limit; call at most once, before release
+        void report(RequestOutcome outcome);
+
+    private:
+        friend struct State;
+        Permit(std::shared_ptr<State> state, RequestPriority priority);
+        void release();
+
+        std::shared_ptr<State> state_;
+        RequestPriority priority_ = RequestPriority::NORMAL;
+        std::chrono::steady_clock::time_point granted_;
+    };
+
+    using Start = std::function<void(Permit)>;
+    using Expired = std::function<void()>;
+
+    explicit RequestScheduler(SchedulerOptions options = {});
+    ~RequestScheduler();
+
+    RequestScheduler(const RequestScheduler&) = delete;
+    RequestScheduler& operator=(const RequestScheduler&) = delete;
+
+    // Block until the request may start. Throws DomeAPIError if its deadline passes
+    // or it is cancelled first.
+    Permit acquire(const RequestConfig& request);
+
+    // Queue a request without blocking. start receives the permit once a slot is
+    // free, on this thread or on the thread releasing a permit; expired runs instead
+    // if the deadline passes while the request waits. Returns a ticket for cancel().
+    uint64_t enqueue(const RequestConfig& request, Start start, Expired expired = {});
+
+    // Remove a waiting request without running either callback. Returns false if it
+    // has already been started or shed.
+    bool cancel(uint64_t ticket);
+
+    // Shed waiting requests whose deadline has passed
+    void expire();
+
+    size_t in_flight() const;
+    size_t queued() const;
+    // Current concurrency limit; max_in_flight unless adaptive
+    size_t limit() const;
+    const SchedulerOptions& options() const { return options_; }
+
+private:
+    SchedulerOptions options_;
+    std::shared_ptr<State> state_;
+};
+
+// Error thrown for requests shed or aborted at their RequestConfig::deadline
+DomeAPIError deadline_exceeded_error();
+
+// Error thrown for requests aborted through their RequestConfig::cancellation
+DomeAPIError request_cancelled_error();
+
+}  // namespace dome
+
+#endif  // DOME_REQUEST_SCHEDULER_HPP
@@ -0,0 +1,82 @@
+#ifndef DOME_SPSC_RING_HPP
+#define DOME_SPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace dome {
+
+/**
+ * Bounded lock-free queue for exactly one producer and one consumer thread.
+ *
+ * The capacity is rounded up to a power of two. Each side keeps its index on
+ * its own cache line and a cached copy of the other side's, so a push or pop
+ * only reads the shared index when the ring looks full or empty.
+ */
+template<typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer: append value, leaving it untouched and returning false when full
+    bool try_push(T&& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: take the oldest value, or return false when empty
+    bool try_pop(T& value) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+        value = std::move(slots_[head & mask_]);
+        slots_[head & mask_] = T();
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate unless called from the consumer
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    std::vector<T> slots_;
+    size_t mask_ = 0;
+
+    alignas(64) std::atomic<size_t> head_{0};  // next slot to pop
+    size_t cached_tail_ = 0;                   // consumer's view of tail_
+
+    alignas(64) std::atomic<size_t> tail_{0};  // next slot to push
+    size_t cached_head_ = 0;                   // producer's view of head_
+};
+
+}  // namespace dome
+
+#endif  // DOME_SPSC_RING_HPP
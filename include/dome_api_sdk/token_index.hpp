@@ -0,0 +1,70 @@
+#ifndef DOME_TOKEN_INDEX_HPP
+#define DOME_TOKEN_INDEX_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+#include "types.hpp"
+
+namespace dome {
+
+/**
+ * Result of a token ID lookup.
+ *
+ * @param market Market the token belongs to (nullptr if unknown)
+ * @param side The market side (side_a or side_b) with this token ID
+ * @param is_side_b Whether the token is the market's side_b
+ */
+struct TokenMatch {
+    const Market* market = nullptr;
+    const MarketSide* side = nullptr;
+    bool is_side_b = false;
+
+    explicit operator bool() const { return market != nullptr; }
+};
+
+/**
+ * Compact token ID -> (market, side) hash index built from Market::side_a / side_b.
+ *
+ * Slots are 8 bytes (a 32-bit hash tag and a packed market/side reference) in
+ * an open-addressing table kept at most half full, so a lookup is one hash, a
+ * short linear probe over a cache line and a single key comparison against the
+ * stored market. The index owns its markets; matches stay valid for the
+ * index's lifetime. Immutable after construction and safe to share across threads.
+ */
+class TokenIndex {
+public:
+    TokenIndex() = default;
+    explicit TokenIndex(std::vector<Market> markets);
+    explicit TokenIndex(const MarketsResponse& response);
+
+    TokenMatch find(std::string_view token_id) const;
+
+    const std::vector<Market>& markets() const { return markets_; }
+
+    // Number of token IDs indexed
+    size_t size() const { return tokens_; }
+
+private:
+    static constexpr uint32_t kEmpty = 0xFFFFFFFFu;
+
+    struct Slot {
+        uint32_t tag = 0;
+        uint32_t entry = kEmpty;  // (market index << 1) | is_side_b
+    };
+
+    const MarketSide& side_of(uint32_t entry) const;
+    void insert(std::string_view token_id, uint32_t entry);
+    void build();
+
+    std::vector<Market> markets_;
+    std::vector<Slot> slots_;
+    size_t mask_ = 0;
+    size_t tokens_ = 0;
+};
+
+}  // namespace dome
+
+#endif  // DOME_TOKEN_INDEX_HPP
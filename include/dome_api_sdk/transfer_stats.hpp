@@ -0,0 +1,53 @@
+#ifndef DOME_TRANSFER_STATS_HPP
+#define DOME_TRANSFER_STATS_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace dome {
+
+/**
+ * Thread-safe byte counters for HTTP responses.
+ *
+ * wire_bytes counts response bodies as they crossed the network (compressed when
+ * the server applied a Content-Encoding); decoded_bytes counts the same bodies
+ * after decompression, i.e. what the JSON parser read. Share one instance between
+ * endpoints through DomeSDKConfig::transfer_stats.
+ */
+class TransferStats {
+public:
+    void record(uint64_t wire_bytes, uint64_t decoded_bytes, uint64_t header_bytes) {
+        responses_.fetch_add(1, std::memory_order_relaxed);
+        wire_bytes_.fetch_add(wire_bytes, std::memory_order_relaxed);
+        decoded_bytes_.fetch_add(decoded_bytes, std::memory_order_relaxed);
+        header_bytes_.fetch_add(header_bytes, std::memory_order_relaxed);
+    }
+
+    uint64_t responses() const { return responses_.load(std::memory_order_relaxed); }
+    uint64_t wire_bytes() const { return wire_bytes_.load(std::memory_order_relaxed); }
+    uint64_t decoded_bytes() const { return decoded_bytes_.load(std::memory_order_relaxed); }
+    uint64_t header_bytes() const { return header_bytes_.load(std::memory_order_relaxed); }
+
+    // decoded_bytes / wire_bytes (1 when nothing was compressed or recorded)
+    double compression_ratio() const {
+        uint64_t wire = wire_bytes();
+        return wire == 0 ? 1.0 : static_cast<double>(decoded_bytes()) / static_cast<double>(wire);
+    }
+
+    void reset() {
+        responses_.store(0, std::memory_order_relaxed);
+        wire_bytes_.store(0, std::memory_order_relaxed);
+        decoded_bytes_.store(0, std::memory_order_relaxed);
+        header_bytes_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> responses_{0};
+    std::atomic<uint64_t> wire_bytes_{0};
+    std::atomic<uint64_t> decoded_bytes_{0};
+    std::atomic<uint64_t> header_bytes_{0};
+};
+
+}  // namespace dome
+
+#endif  // DOME_TRANSFER_STATS_HPP
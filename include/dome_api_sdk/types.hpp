@@ -8,9 +8,20 @@
 #include <functional>
 #include <cstdint>
 #include <stdexcept>
+#include <memory>
+#include <chrono>
+
+#include "intern.hpp"
+#include "decimal.hpp"
+#include "transfer_stats.hpp"
+#include "cancellation.hpp"
 
 namespace dome {
 
+class ConnectionPool;
+class RequestScheduler;
+class CircuitBreaker;
+
 // Configuration Types
 
 /**
@@ -19,22 +30,84 @@ namespace dome {
  * @param api_key Authentication token for API requests
  * @param base_url Base URL for the API (defaults to https://api.domeapi.io/v1)
  * @param timeout Request timeout in seconds (defaults to 30)
+ * @param connect_timeout Limit on establishing a connection, including DNS and TLS (0 = libcurl's 300 s)
+ * @param first_byte_timeout Limit from the start of a request to the first response byte (0 = none)
+ * @param intern_table Shared table for identifier strings in decoded records (optional)
+ * @param accept_encoding Accept-Encoding to negotiate, e.g. "gzip" or "br, gzip" (empty = every
+ *        encoding libcurl was built with; nullopt = request uncompressed responses)
+ * @param transfer_stats Counters for compressed and decompressed response bytes (optional)
+ * @param connection_pool Pool of connections, DNS results and TLS sessions (optional; each
+ *        PolymarketClient creates one shared by its endpoints)
+ * @param warmup_connections Connections to open when the client is constructed (0 = lazily)
+ * @param keepalive_interval Seconds between keepalive re-warms of the pool (0 = off)
+ * @param scheduler Admission control by RequestConfig priority and deadline, shared by every
+ *        endpoint of the client (optional; without it requests start immediately)
+ * @param circuit_breaker Per-endpoint circuit breaker that fails fast while the API is
+ *        overloaded (optional)
  */
 struct DomeSDKConfig {
     std::string api_key;
     std::string base_url = "https://api.domeapi.io/v1";
     int64_t timeout = 30.0f;
+    std::chrono::milliseconds connect_timeout{0};
+    std::chrono::milliseconds first_byte_timeout{0};
+    std::shared_ptr<InternTable> intern_table;
+    std::optional<std::string> accept_encoding = std::string();
+    std::shared_ptr<TransferStats> transfer_stats;
+    std::shared_ptr<ConnectionPool> connection_pool;
+    size_t warmup_connections = 0;
+    int64_t keepalive_interval = 0;
+    std::shared_ptr<RequestScheduler> scheduler;
+    std::shared_ptr<CircuitBreaker> circuit_breaker;
+};
+
+// What a finished request says about the server's health. OVERLOADED covers 429,
+// 5xx, timeouts and transport failures; FAILED other errors, which a healthy server
+// returns too; IGNORED cancelled calls.
+enum class RequestOutcome {
+    SUCCESS,
+    FAILED,
+    OVERLOADED,
+    IGNORED
+};
+
+// Scheduling class of a request. INTERACTIVE requests are started before NORMAL
+// ones and NORMAL before BULK.
+enum class RequestPriority {
+    INTERACTIVE,
+    NORMAL,
+    BULK
 };
 
 /**
  * Configuration for individual requests.
  * 
- * @param timeout Request timeout in seconds
+ * @param timeout Request timeout in seconds (0 = the client's timeout)
+ * @param connect_timeout Connection timeout (0 = the client's)
+ * @param first_byte_timeout Time allowed until the first response byte (0 = the client's)
+ * @param cancellation Token that aborts the request when cancelled
  * @param headers Additional headers to include
+ * @param priority Scheduling class when the client has a RequestScheduler
+ * @param deadline Time after which the response is no longer useful: the request is
+ *        shed if it has not started by then and aborted if it is still running
  */
 struct RequestConfig {
-    int64_t timeout = 30.0f;
+    int64_t timeout = 0;
+    std::chrono::milliseconds connect_timeout{0};
+    std::chrono::milliseconds first_byte_timeout{0};
+    CancellationToken cancellation;
     std::map<std::string, std::string> headers;
+    RequestPriority priority = RequestPriority::NORMAL;
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+
+    // Config with a deadline budget from now
+    static RequestConfig within(std::chrono::milliseconds budget,
+                                RequestPriority priority = RequestPriority::INTERACTIVE) {
+        RequestConfig config;
+        config.priority = priority;
+        config.deadline = std::chrono::steady_clock::now() + budget;
+        return config;
+    }
 };
 
 // Order Side enum
@@ -70,57 +143,39 @@ struct GetMarketPriceParams {
 // Candlestick Types
 
 /**
- * Price data for a candlestick.
+ * Price data for a candlestick, in dollars.
+ * 
+ * Decoded from the exact `*_dollars` text when present, otherwise from the numeric field.
  * 
  * @param open Opening price
  * @param high Highest price
  * @param low Lowest price
  * @param close Closing price
- * @param open_dollars Opening price in dollars
- * @param high_dollars Highest price in dollars
- * @param low_dollars Lowest price in dollars
- * @param close_dollars Closing price in dollars
  * @param mean Mean price
- * @param mean_dollars Mean price in dollars
  * @param previous Previous price
- * @param previous_dollars Previous price in dollars
  */
 struct CandlestickPrice {
-    double open;
-    double high;
-    double low;
-    double close;
-    std::string open_dollars;
-    std::string high_dollars;
-    std::string low_dollars;
-    std::string close_dollars;
-    double mean;
-    std::string mean_dollars;
-    double previous;
-    std::string previous_dollars;
+    Decimal open;
+    Decimal high;
+    Decimal low;
+    Decimal close;
+    Decimal mean;
+    Decimal previous;
 };
 
 /**
- * Ask/Bid data for a candlestick.
+ * Ask/Bid data for a candlestick, in dollars.
  * 
  * @param open Opening price
  * @param close Closing price
  * @param high Highest price
  * @param low Lowest price
- * @param open_dollars Opening price in dollars
- * @param close_dollars Closing price in dollars
- * @param high_dollars Highest price in dollars
- * @param low_dollars Lowest price in dollars
  */
 struct CandlestickAskBid {
-    double open;
-    double close;
-    double high;
-    double low;
-    std::string open_dollars;
-    std::string close_dollars;
-    std::string high_dollars;
-    std::string low_dollars;
+    Decimal open;
+    Decimal close;
+    Decimal high;
+    Decimal low;
 };
 
 /**
@@ -239,6 +294,53 @@ struct GetWalletPnLParams {
     std::optional<int64_t> end_time;
 };
 
+/**
+ * Options for bulk wallet PnL fetches.
+ *
+ * @param max_concurrency Requests in flight at once
+ * @param requests_per_second Maximum request start rate (0 = unlimited)
+ * @param forward_fill Carry each wallet's last pnl_to_date into later timestamps it has no point for
+ */
+struct BulkPnLOptions {
+    size_t max_concurrency = 16;
+    double requests_per_second = 0;
+    bool forward_fill = false;
+};
+
+/**
+ * Wallet whose PnL request failed in a bulk fetch.
+ *
+ * @param wallet_address Wallet address
+ * @param status_code HTTP status code, or -1 for transport/parse errors
+ * @param message Error message
+ */
+struct WalletPnLError {
+    std::string wallet_address;
+    int status_code;
+    std::string message;
+};
+
+/**
+ * PnL for many wallets merged into one wallet x timestamp matrix.
+ *
+ * pnl is row-major: pnl[row * timestamps.size() + column] is the pnl_to_date of
+ * wallets[row] at timestamps[column], or NaN where the wallet has no point.
+ *
+ * @param wallets Wallet addresses that succeeded, in request order (rows)
+ * @param timestamps Union of all returned timestamps, ascending (columns)
+ * @param pnl PnL values, row-major
+ * @param errors Wallets whose request failed
+ */
+struct WalletPnLMatrix {
+    std::vector<std::string> wallets;
+    std::vector<int64_t> timestamps;
+    std::vector<double> pnl;
+    std::vector<WalletPnLError> errors;
+
+    double at(size_t row, size_t column) const { return pnl[row * timestamps.size() + column]; }
+    const double* row(size_t row) const { return pnl.data() + row * timestamps.size(); }
+};
+
 // Orders Types
 
 /**
@@ -275,16 +377,16 @@ struct Pagination {
  * @param taker Taker address that was part of this trade (optional, may be CTF exchange)
  */
 struct Order {
-    std::string token_id;
-    std::string token_label;
+    InternedString token_id;
+    InternedString token_label;
     std::string side;  // "BUY" or "SELL"
-    std::string market_slug;
-    std::string condition_id;
-    float shares;
-    double shares_normalized;
-    double price;
+    InternedString market_slug;
+    InternedString condition_id;
+    int64_t shares;
+    Decimal shares_normalized;
+    Decimal price;
     std::string tx_hash;
-    std::string title;
+    InternedString title;
     int64_t timestamp;
     std::string order_hash;
     std::string user;
@@ -328,6 +430,17 @@ struct GetOrdersParams {
 
 // Polymarket Orderbooks Types
 
+/**
+ * Orderbook price level.
+ * 
+ * @param price Level price
+ * @param size Resting size at this price
+ */
+struct OrderbookLevel {
+    Decimal price;
+    Decimal size;
+};
+
 /**
  * Orderbook snapshot data.
  * 
@@ -343,14 +456,14 @@ struct GetOrdersParams {
  * @param market Market identifier
  */
 struct OrderbookSnapshot {
-    std::vector<std::map<std::string, std::string>> asks;
-    std::vector<std::map<std::string, std::string>> bids;
+    std::vector<OrderbookLevel> asks;
+    std::vector<OrderbookLevel> bids;
     std::string hash;
-    std::string minOrderSize;
+    Decimal minOrderSize;
     bool negRisk;
     std::string assetId;
     int64_t timestamp;
-    std::string tickSize;
+    Decimal tickSize;
     int64_t indexedAt;
     std::string market;
 };
@@ -510,15 +623,15 @@ struct GetMarketsParams {
  * @param user User wallet address
  */
 struct Activity {
-    std::string token_id;
+    InternedString token_id;
     std::string side;  // "MERGE", "SPLIT", "REDEEM"
-    std::string market_slug;
-    std::string condition_id;
+    InternedString market_slug;
+    InternedString condition_id;
     int64_t shares;
-    double shares_normalized;
-    double price;
+    Decimal shares_normalized;
+    Decimal price;
     std::string tx_hash;
-    std::string title;
+    InternedString title;
     int64_t timestamp;
     std::string order_hash;
     std::string user;
@@ -0,0 +1,56 @@
+#ifndef DOME_URL_ENCODE_HPP
+#define DOME_URL_ENCODE_HPP
+
+#include <string>
+#include <string_view>
+#include <map>
+#include <cstdint>
+
+namespace dome {
+
+// Append value to out, percent-encoding everything except the RFC 3986 unreserved
+// characters (ALPHA / DIGIT / "-" / "." / "_" / "~"), the same set curl_easy_escape keeps
+void append_url_encoded(std::string& out, std::string_view value);
+
+std::string url_encode(std::string_view value);
+
+/**
+ * Builds a URL with a query string in one reserved buffer.
+ *
+ *   QueryBuilder url("https://api.domeapi.io/v1/polymarket/orders");
+ *   url.add("market_slug", slug).add("limit", 100);
+ *   curl_easy_setopt(curl, CURLOPT_URL, url.str().c_str());
+ *
+ * Keys and values are percent-encoded in place; nothing is allocated beyond
+ * buffer growth, and reset() keeps the capacity for the next URL.
+ */
+class QueryBuilder {
+public:
+    QueryBuilder() = default;
+    explicit QueryBuilder(std::string_view base, size_t reserve = 256);
+
+    // Start a new URL from base, keeping the buffer's capacity
+    QueryBuilder& reset(std::string_view base);
+
+    // Append path text as is; call before the first add
+    QueryBuilder& append_path(std::string_view path);
+
+    QueryBuilder& add(std::string_view key, std::string_view value);
+    QueryBuilder& add(std::string_view key, int64_t value);
+
+    // Add every parameter in key order
+    QueryBuilder& add_all(const std::map<std::string, std::string>& params);
+
+    const std::string& str() const { return buffer_; }
+    std::string release() { return std::move(buffer_); }
+
+private:
+    void separator();
+
+    std::string buffer_;
+    bool has_query_ = false;
+};
+
+}  // namespace dome
+
+#endif  // DOME_URL_ENCODE_HPP
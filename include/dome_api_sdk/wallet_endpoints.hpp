@@ -12,7 +12,20 @@ public:
 
     // Get wallet PnL data
     // Endpoint: /polymarket/wallet/pnl/{wallet_address}
-    WalletPnLResponse get_wallet_pnl(const GetWalletPnLParams& params);
+    WalletPnLResponse get_wallet_pnl(const GetWalletPnLParams& params, const RequestConfig& request_config = {});
+    AsyncOp<WalletPnLResponse> get_wallet_pnl_async(AsyncLoop& loop, const GetWalletPnLParams& params,
+                                                     const RequestConfig& request_config = {});
+
+    // Get PnL for many wallets concurrently over shared connections, merged into
+    // one wallet x timestamp matrix. Failed wallets are reported in errors.
+    // request_config applies to each wallet's request (see HttpClient::get_many).
+    WalletPnLMatrix get_wallet_pnl_bulk(const std::vector<GetWalletPnLParams>& params,
+                                        const BulkPnLOptions& options = {},
+                                        const RequestConfig& request_config = {});
+
+private:
+    static BatchRequest make_request(const GetWalletPnLParams& params);
+    static WalletPnLResponse parse_response(const nlohmann::json& json);
 };
 
 }  // namespace dome
@@ -0,0 +1,85 @@
+#ifndef DOME_WIDE_INT_HPP
+#define DOME_WIDE_INT_HPP
+
+#include <cstdint>
+
+namespace dome {
+
+/**
+ * Unsigned 128-bit value as two 64-bit halves, for the few places that need a full
+ * 64x64-bit product: Decimal multiplication and division, Uint256 base conversion
+ * and volume-weighted candle means. The helpers use the compiler's __int128 where
+ * there is one (GCC, Clang) and 32-bit partial products elsewhere (e.g. MSVC, or
+ * when built with DOME_FORCE_SCALAR).
+ */
+struct Uint128 {
+    uint64_t high = 0;
+    uint64_t low = 0;
+};
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 NativeUint128;
+#endif
+
+// a * b + addend; cannot overflow
+inline Uint128 mul_wide(uint64_t a, uint64_t b, uint64_t addend = 0) {
+#if defined(__SIZEOF_INT128__) && !defined(DOME_FORCE_SCALAR)
+    NativeUint128 product = static_cast<NativeUint128>(a) * b + addend;
+    return {static_cast<uint64_t>(product >> 64), static_cast<uint64_t>(product)};
+#else
+    uint64_t a_low = a & 0xFFFFFFFFull, a_high = a >> 32;
+    uint64_t b_low = b & 0xFFFFFFFFull, b_high = b >> 32;
+    uint64_t low_low = a_low * b_low;
+    uint64_t high_low = a_high * b_low;
+    uint64_t middle = (low_low >> 32) + (high_low & 0xFFFFFFFFull) + a_low * b_high;
+    Uint128 product{a_high * b_high + (high_low >> 32) + (middle >> 32), (middle << 32) | (low_low & 0xFFFFFFFFull)};
+    product.low += addend;
+    product.high += product.low < addend;
+    return product;
+#endif
+}
+
+// value / divisor and its remainder; requires value.high < divisor so the quotient fits
+inline uint64_t div_wide(Uint128 value, uint64_t divisor, uint64_t& remainder) {
+#if defined(__SIZEOF_INT128__) && !defined(DOME_FORCE_SCALAR)
+    NativeUint128 dividend = (static_cast<NativeUint128>(value.high) << 64) | value.low;
+    remainder = static_cast<uint64_t>(dividend % divisor);
+    return static_cast<uint64_t>(dividend / divisor);
+#else
+    // Shift-subtract; the running remainder stays below divisor
+    uint64_t quotient = 0;
+    uint64_t rest = value.high;
+    for (int bit = 63; bit >= 0; --bit) {
+        bool carry = (rest >> 63) != 0;
+        rest = (rest << 1) | ((value.low >> bit) & 1);
+        quotient <<= 1;
+        if (carry || rest >= divisor) {
+            rest -= divisor;
+            quotient |= 1;
+        }
+    }
+    remainder = rest;
+    return quotient;
+#endif
+}
+
+inline Uint128 add_wide(Uint128 a, Uint128 b) {
+    Uint128 sum{a.high + b.high, a.low + b.low};
+    sum.high += sum.low < a.low;
+    return sum;
+}
+
+// a - b; requires !less_wide(a, b)
+inline Uint128 sub_wide(Uint128 a, Uint128 b) {
+    Uint128 difference{a.high - b.high, a.low - b.low};
+    difference.high -= a.low < b.low;
+    return difference;
+}
+
+inline bool less_wide(Uint128 a, Uint128 b) {
+    return a.high != b.high ? a.high < b.high : a.low < b.low;
+}
+
+}  // namespace dome
+
+#endif  // DOME_WIDE_INT_HPP
@@ -16,8 +16,15 @@ BaseEndpoint::BaseEndpoint(const DomeSDKConfig& config) : config_(config) {
     http_client_ = std::make_shared<HttpClient>(
         config.base_url,
         api_key,
-        config.timeout
+        config.timeout,
+        config.connection_pool
     );
+    http_client_->set_accept_encoding(config.accept_encoding);
+    http_client_->set_transfer_stats(config.transfer_stats);
+    http_client_->set_scheduler(config.scheduler);
+    http_client_->set_circuit_breaker(config.circuit_breaker);
+    http_client_->set_connect_timeout(config.connect_timeout);
+    http_client_->set_first_byte_timeout(config.first_byte_timeout);
 }
 
 }  // namespace dome
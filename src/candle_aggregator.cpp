@@ -0,0 +1,215 @@
+#include "dome_api_sdk/candle_aggregator.hpp"
+
+#include <algorithm>
+
+namespace dome {
+
+CandleAggregator::CandleAggregator(CandleAggregatorOptions options)
+    : options_(options) {
+    if (options_.interval_seconds <= 0) {
+        options_.interval_seconds = 60;
+    }
+    if (options_.capacity == 0) {
+        options_.capacity = 1;
+    }
+}
+
+int64_t CandleAggregator::period_start(int64_t timestamp) const {
+    int64_t interval = options_.interval_seconds;
+    return timestamp - ((timestamp % interval) + interval) % interval;
+}
+
+CandleAggregator::Slot* CandleAggregator::slot_for(Series& series, int64_t start,
+                                                   std::optional<Candle>& closed) {
+    auto append = [&](int64_t period) -> Slot* {
+        Slot slot;
+        slot.candle.start_time = period;
+        if (series.ring.size() < options_.capacity) {
+            series.ring.push_back(slot);
+            ++series.count;
+        } else {
+            series.ring[series.head] = slot;
+            series.head = (series.head + 1) % series.ring.size();
+        }
+        return &series.at(series.count - 1);
+    };
+
+    if (series.count == 0) {
+        return append(start);
+    }
+
+    Slot& latest = series.at(series.count - 1);
+    if (start == latest.candle.start_time) {
+        return &latest;
+    }
+    if (start > latest.candle.start_time) {
+        closed = latest.candle;
+        return append(start);
+    }
+
+    // Late trade: walk back from the newest period
+    for (size_t i = series.count; i-- > 0;) {
+        Slot& slot = series.at(i);
+        if (slot.candle.start_time == start) {
+            return &slot;
+        }
+        if (slot.candle.start_time < start) {
+            break;
+        }
+    }
+    if (series.count == options_.capacity && series.at(0).candle.start_time > start) {
+        return nullptr;  // Older than the retained window
+    }
+
+    // Period fell in a gap; rebuild the ring in order with the new slot inserted
+    std::vector<Slot> ordered;
+    ordered.reserve(series.count + 1);
+    for (size_t i = 0; i < series.count; ++i) {
+        ordered.push_back(series.at(i));
+    }
+    auto position = std::find_if(ordered.begin(), ordered.end(),
+                                 [start](const Slot& slot) { return slot.candle.start_time > start; });
+    Slot slot;
+    slot.candle.start_time = start;
+    size_t index = static_cast<size_t>(position - ordered.begin());
+    ordered.insert(position, slot);
+    if (ordered.size() > options_.capacity) {
+        ordered.erase(ordered.begin());
+        --index;
+    }
+    series.ring = std::move(ordered);
+    series.head = 0;
+    series.count = series.ring.size();
+    return &series.ring[index];
+}
+
+void CandleAggregator::merge(Slot& slot, int64_t first_time, int64_t last_time, Decimal open,
+                             Decimal high, Decimal low, Decimal close, Decimal volume,
+                             Decimal notional, int64_t trades) {
+    Candle& candle = slot.candle;
+    if (!slot.filled) {
+        candle.open = open;
+        candle.high = high;
+        candle.low = low;
+        candle.close = close;
+        slot.first_trade_time = first_time;
+        slot.last_trade_time = last_time;
+        slot.filled = true;
+    } else {
+        if (first_time < slot.first_trade_time) {
+            candle.open = open;
+            slot.first_trade_time = first_time;
+        }
+        if (last_time >= slot.last_trade_time) {
+            candle.close = close;
+            slot.last_trade_time = last_time;
+        }
+        candle.high = std::max(candle.high, high);
+        candle.low = std::min(candle.low, low);
+    }
+    candle.volume += volume;
+    candle.notional += notional;
+    candle.trades += trades;
+}
+
+void CandleAggregator::add_trade(const std::string& condition_id, const std::string& token_id,
+                                 int64_t timestamp, Decimal price, Decimal shares) {
+    std::optional<Candle> closed;
+    CandleClosedCallback callback;
+    std::string series_condition;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Series& series = series_[token_id];
+        if (series.condition_id.empty()) {
+            series.condition_id = condition_id;
+        }
+        Slot* slot = slot_for(series, period_start(timestamp), closed);
+        if (slot != nullptr) {
+            merge(*slot, timestamp, timestamp, price, price, price, price, shares, price * shares, 1);
+        }
+        if (closed.has_value() && closed_callback_) {
+            callback = closed_callback_;
+            series_condition = series.condition_id;
+        }
+    }
+    if (callback) {
+        callback(series_condition, token_id, *closed);
+    }
+}
+
+void CandleAggregator::on_order(const Order& order) {
+    add_trade(order.condition_id, order.token_id, order.timestamp, order.price, order.shares_normalized);
+}
+
+void CandleAggregator::on_order_event(const WebSocketOrderEvent& event) {
+    on_order(event.data);
+}
+
+void CandleAggregator::seed(const OrdersResponse& orders) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::optional<Candle> ignored;
+    for (const auto& order : orders.orders) {
+        Series& series = series_[order.token_id];
+        if (series.condition_id.empty()) {
+            series.condition_id = order.condition_id;
+        }
+        Slot* slot = slot_for(series, period_start(order.timestamp), ignored);
+        if (slot != nullptr) {
+            merge(*slot, order.timestamp, order.timestamp, order.price, order.price, order.price,
+                  order.price, order.shares_normalized, order.price * order.shares_normalized, 1);
+        }
+    }
+}
+
+void CandleAggregator::seed(const std::string& condition_id, const std::string& token_id,
+                            const CandlesticksResponse& candlesticks, int source_interval_minutes) {
+    int64_t source_seconds = static_cast<int64_t>(source_interval_minutes) * 60;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::optional<Candle> ignored;
+    Series& series = series_[token_id];
+    if (series.condition_id.empty()) {
+        series.condition_id = condition_id;
+    }
+    for (const auto& source : candlesticks.candlesticks) {
+        int64_t begin = source.end_period_ts - source_seconds;
+        Slot* slot = slot_for(series, period_start(begin), ignored);
+        if (slot == nullptr) {
+            continue;
+        }
+        Decimal volume = Decimal::from_int(source.volume);
+        const CandlestickPrice& p = source.price;
+        merge(*slot, begin, source.end_period_ts - 1, p.open, p.high, p.low, p.close, volume,
+              p.mean * volume, 0);
+    }
+}
+
+std::vector<Candle> CandleAggregator::candles(const std::string& token_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Candle> result;
+    auto it = series_.find(token_id);
+    if (it == series_.end()) {
+        return result;
+    }
+    result.reserve(it->second.count);
+    for (size_t i = 0; i < it->second.count; ++i) {
+        result.push_back(it->second.at(i).candle);
+    }
+    return result;
+}
+
+std::optional<Candle> CandleAggregator::latest(const std::string& token_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = series_.find(token_id);
+    if (it == series_.end() || it->second.count == 0) {
+        return std::nullopt;
+    }
+    return it->second.at(it->second.count - 1).candle;
+}
+
+void CandleAggregator::set_candle_closed_callback(CandleClosedCallback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_callback_ = std::move(callback);
+}
+
+}  // namespace dome
@@ -0,0 +1,164 @@
+#include "dome_api_sdk/candle_resampler.hpp"
+#include "dome_api_sdk/wide_int.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace dome {
+
+static uint64_t magnitude_of(int64_t value) {
+    return value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+}
+
+// Signed 128-bit sum of int64 products, kept as its positive and negative parts
+struct WideSum {
+    Uint128 positive;
+    Uint128 negative;
+
+    void add(int64_t value, int64_t weight) {
+        Uint128 product = mul_wide(magnitude_of(value), magnitude_of(weight));
+        Uint128& part = (value < 0) != (weight < 0) ? negative : positive;
+        part = add_wide(part, product);
+    }
+
+    // Sum / total rounded half away from zero. total is the sum of the (non-negative)
+    // weights, so the quotient lies within the range of the values.
+    int64_t mean(uint64_t total) const {
+        bool is_negative = less_wide(positive, negative);
+        Uint128 magnitude = is_negative ? sub_wide(negative, positive) : sub_wide(positive, negative);
+        uint64_t remainder = 0;
+        uint64_t quotient = div_wide(magnitude, total, remainder);
+        if (remainder >= total - remainder) ++quotient;
+        return is_negative ? -static_cast<int64_t>(quotient) : static_cast<int64_t>(quotient);
+    }
+};
+
+// Running state of the output bar currently being built for one target interval
+struct Bucket {
+    int64_t period_seconds = 0;
+    int64_t end = 0;
+    bool open = false;
+    CandlestickData bar{};
+    WideSum weighted_mean;  // sum(mean.raw * volume)
+    WideSum mean_sum;       // sum(mean.raw), for bars without volume
+    int64_t bars = 0;
+};
+
+static void roll_ask_bid(CandlestickAskBid& into, const CandlestickAskBid& from) {
+    into.close = from.close;
+    into.high = std::max(into.high, from.high);
+    into.low = std::min(into.low, from.low);
+}
+
+static void start_bucket(Bucket& bucket, int64_t end, const CandlestickData& source) {
+    bucket.open = true;
+    bucket.end = end;
+    bucket.bar = source;
+    bucket.bar.end_period_ts = end;
+    bucket.weighted_mean = WideSum();
+    bucket.weighted_mean.add(source.price.mean.raw(), source.volume);
+    bucket.mean_sum = WideSum();
+    bucket.mean_sum.add(source.price.mean.raw(), 1);
+    bucket.bars = 1;
+}
+
+static void add_to_bucket(Bucket& bucket, const CandlestickData& source) {
+    CandlestickData& bar = bucket.bar;
+    bar.price.close = source.price.close;
+    bar.price.high = std::max(bar.price.high, source.price.high);
+    bar.price.low = std::min(bar.price.low, source.price.low);
+    roll_ask_bid(bar.yes_ask, source.yes_ask);
+    roll_ask_bid(bar.yes_bid, source.yes_bid);
+    bar.volume += source.volume;
+    bar.open_interest = source.open_interest;
+    bucket.weighted_mean.add(source.price.mean.raw(), source.volume);
+    bucket.mean_sum.add(source.price.mean.raw(), 1);
+    ++bucket.bars;
+}
+
+static void close_bucket(Bucket& bucket, std::vector<CandlestickData>& out) {
+    if (!bucket.open) {
+        return;
+    }
+    int64_t mean = bucket.bar.volume > 0 ? bucket.weighted_mean.mean(static_cast<uint64_t>(bucket.bar.volume))
+                                         : bucket.mean_sum.mean(static_cast<uint64_t>(bucket.bars));
+    bucket.bar.price.mean = Decimal::from_raw(mean);
+    out.push_back(bucket.bar);
+    bucket.open = false;
+}
+
+// Smallest multiple of period that is >= timestamp
+static int64_t bucket_end(int64_t timestamp, int64_t period) {
+    int64_t remainder = ((timestamp % period) + period) % period;
+    return remainder == 0 ? timestamp : timestamp - remainder + period;
+}
+
+std::vector<std::vector<CandlestickData>> resample_candlesticks(
+    const CandlestickData* candlesticks,
+    size_t count,
+    int source_interval_minutes,
+    const std::vector<int>& target_interval_minutes) {
+    if (source_interval_minutes <= 0) {
+        throw std::invalid_argument("source interval must be positive");
+    }
+
+    std::vector<Bucket> buckets(target_interval_minutes.size());
+    std::vector<std::vector<CandlestickData>> result(target_interval_minutes.size());
+    for (size_t t = 0; t < target_interval_minutes.size(); ++t) {
+        int target = target_interval_minutes[t];
+        if (target < source_interval_minutes || target % source_interval_minutes != 0) {
+            throw std::invalid_argument("target interval " + std::to_string(target) +
+                                        " is not a multiple of source interval " +
+                                        std::to_string(source_interval_minutes));
+        }
+        buckets[t].period_seconds = static_cast<int64_t>(target) * 60;
+        result[t].reserve(count * source_interval_minutes / target + 1);
+    }
+
+    auto by_end = [](const CandlestickData& a, const CandlestickData& b) {
+        return a.end_period_ts < b.end_period_ts;
+    };
+    const CandlestickData* source = candlesticks;
+    std::vector<CandlestickData> sorted;
+    if (!std::is_sorted(candlesticks, candlesticks + count, by_end)) {
+        sorted.assign(candlesticks, candlesticks + count);
+        std::stable_sort(sorted.begin(), sorted.end(), by_end);
+        source = sorted.data();
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const CandlestickData& bar = source[i];
+        for (size_t t = 0; t < buckets.size(); ++t) {
+            Bucket& bucket = buckets[t];
+            // Input is sorted, so a bar no later than the open bucket's end belongs to it
+            if (bucket.open && bar.end_period_ts <= bucket.end) {
+                add_to_bucket(bucket, bar);
+            } else {
+                close_bucket(bucket, result[t]);
+                start_bucket(bucket, bucket_end(bar.end_period_ts, bucket.period_seconds), bar);
+            }
+        }
+    }
+    for (size_t t = 0; t < buckets.size(); ++t) {
+        close_bucket(buckets[t], result[t]);
+    }
+    return result;
+}
+
+std::vector<std::vector<CandlestickData>> resample_candlesticks(
+    const std::vector<CandlestickData>& candlesticks,
+    int source_interval_minutes,
+    const std::vector<int>& target_interval_minutes) {
+    return resample_candlesticks(candlesticks.data(), candlesticks.size(), source_interval_minutes,
+                                 target_interval_minutes);
+}
+
+std::vector<std::vector<CandlestickData>> resample_candlesticks(
+    const CandlesticksResponse& response,
+    int source_interval_minutes,
+    const std::vector<int>& target_interval_minutes) {
+    return resample_candlesticks(response.candlesticks, source_interval_minutes, target_interval_minutes);
+}
+
+}  // namespace dome
@@ -0,0 +1,139 @@
+#include "dome_api_sdk/circuit_breaker.hpp"
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace dome {
+
+using Clock = std::chrono::steady_clock;
+
+static std::string open_message(const std::string& route, std::chrono::milliseconds retry_after) {
+    return "Circuit open for " + route + "; retry in " + std::to_string(retry_after.count()) + " ms";
+}
+
+CircuitOpenError::CircuitOpenError(const std::string& route, std::chrono::milliseconds retry_after)
+    : DomeAPIError(-1, open_message(route, retry_after)), route(route), retry_after(retry_after) {}
+
+struct CircuitBreaker::State {
+    struct Circuit {
+        Status status = Status::CLOSED;
+        std::vector<bool> outcomes;  // ring of recent outcomes, true = overloaded
+        size_t next = 0;
+        size_t failures = 0;
+        Clock::time_point open_until;
+        Ticket probe = 0;  // ticket of the running probe, 0 when none
+
+        void clear_window() {
+            outcomes.clear();
+            next = 0;
+            failures = 0;
+        }
+    };
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Circuit> circuits;
+    Ticket next_probe = 1;
+};
+
+CircuitBreaker::CircuitBreaker(CircuitBreakerOptions options)
+    : options_(options), state_(std::make_unique<State>()) {
+    options_.window = std::max<size_t>(1, options_.window);
+    options_.min_calls = std::clamp<size_t>(options_.min_calls, 1, options_.window);
+    options_.failure_ratio = std::clamp(options_.failure_ratio, 0.0, 1.0);
+}
+
+CircuitBreaker::~CircuitBreaker() = default;
+
+CircuitBreaker::Ticket CircuitBreaker::allow(const std::string& route) {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    auto it = state_->circuits.find(route);
+    if (it == state_->circuits.end() || it->second.status == Status::CLOSED) {
+        return 0;
+    }
+    auto& circuit = it->second;
+    auto now = Clock::now();
+    if (circuit.status == Status::OPEN && now >= circuit.open_until) {
+        circuit.status = Status::HALF_OPEN;
+    }
+    if (circuit.status == Status::HALF_OPEN && circuit.probe == 0) {
+        circuit.probe = state_->next_probe++;
+        return circuit.probe;
+    }
+    auto remaining = std::max(circuit.open_until - now, Clock::duration::zero());
+    throw CircuitOpenError(route, std::chrono::ceil<std::chrono::milliseconds>(remaining));
+}
+
+void CircuitBreaker::record(const std::string& route, RequestOutcome outcome, Ticket ticket) {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    auto& circuit = state_->circuits[route];
+    bool own_probe = ticket != 0 && ticket == circuit.probe;
+    if (outcome == RequestOutcome::IGNORED) {
+        if (own_probe) {
+            circuit.probe = 0;
+        }
+        return;
+    }
+    bool overloaded = outcome == RequestOutcome::OVERLOADED;
+
+    if (circuit.status != Status::CLOSED) {
+        // Only the probe's outcome decides; stragglers from before the circuit opened don't
+        if (own_probe) {
+            circuit.probe = 0;
+            if (overloaded) {
+                circuit.status = Status::OPEN;
+                circuit.open_until = Clock::now() + options_.open_duration;
+            } else {
+                circuit.status = Status::CLOSED;
+                circuit.clear_window();
+            }
+        }
+        return;
+    }
+
+    if (circuit.outcomes.size() < options_.window) {
+        circuit.outcomes.push_back(overloaded);
+    } else {
+        circuit.failures -= circuit.outcomes[circuit.next];
+        circuit.outcomes[circuit.next] = overloaded;
+        circuit.next = (circuit.next + 1) % options_.window;
+    }
+    circuit.failures += overloaded;
+
+    size_t calls = circuit.outcomes.size();
+    if (calls >= options_.min_calls && circuit.failures >= options_.failure_ratio * calls && circuit.failures > 0) {
+        circuit.status = Status::OPEN;
+        circuit.open_until = Clock::now() + options_.open_duration;
+        circuit.clear_window();
+    }
+}
+
+CircuitBreaker::Status CircuitBreaker::status(const std::string& route) const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    auto it = state_->circuits.find(route);
+    if (it == state_->circuits.end()) {
+        return Status::CLOSED;
+    }
+    if (it->second.status == Status::OPEN && Clock::now() >= it->second.open_until) {
+        return Status::HALF_OPEN;
+    }
+    return it->second.status;
+}
+
+void CircuitBreaker::reset() {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->circuits.clear();
+}
+
+std::string CircuitBreaker::route_of(const std::string& endpoint) {
+    size_t end = std::min(endpoint.find('?'), endpoint.size());
+    size_t segments = 0;
+    for (size_t i = 0; i < end; ++i) {
+        if (endpoint[i] == '/' && i > 0 && ++segments == 2) {
+            return endpoint.substr(0, i);
+        }
+    }
+    return endpoint.substr(0, end);
+}
+
+}  // namespace dome
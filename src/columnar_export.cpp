@@ -0,0 +1,183 @@
+#include "dome_api_sdk/columnar_export.hpp"
+#include "dome_api_sdk/pager.hpp"
+
+namespace dome {
+
+// StringColumn
+
+void StringColumn::append(const std::string& value) {
+    data.append(value);
+    offsets.push_back(static_cast<int32_t>(data.size()));
+}
+
+std::string StringColumn::at(size_t row) const {
+    return data.substr(offsets[row], offsets[row + 1] - offsets[row]);
+}
+
+void StringColumn::clear() {
+    offsets.assign(1, 0);
+    data.clear();
+}
+
+// DictionaryColumn
+
+void DictionaryColumn::append(const std::string& value) {
+    auto it = lookup_.find(value);
+    if (it == lookup_.end()) {
+        int32_t index = static_cast<int32_t>(dictionary.size());
+        dictionary.append(value);
+        it = lookup_.emplace(value, index).first;
+    }
+    indices.push_back(it->second);
+}
+
+std::string DictionaryColumn::at(size_t row) const {
+    return dictionary.at(static_cast<size_t>(indices[row]));
+}
+
+void DictionaryColumn::clear() {
+    dictionary.clear();
+    indices.clear();
+    lookup_.clear();
+}
+
+// OrderColumnBatch
+
+void OrderColumnBatch::append(const Order& order) {
+    token_id.append(order.token_id);
+    token_label.append(order.token_label);
+    side.append(order.side);
+    market_slug.append(order.market_slug);
+    condition_id.append(order.condition_id);
+    title.append(order.title);
+    shares.push_back(order.shares);
+    shares_normalized.push_back(order.shares_normalized.raw());
+    price.push_back(order.price.raw());
+    tx_hash.append(order.tx_hash);
+    timestamp.push_back(order.timestamp);
+    order_hash.append(order.order_hash);
+    user.append(order.user);
+    taker.append(order.taker.value_or(""));
+    taker_valid.push_back(order.taker.has_value() ? 1 : 0);
+}
+
+void OrderColumnBatch::reserve(size_t rows) {
+    for (auto* column : {&token_id, &token_label, &side, &market_slug, &condition_id, &title}) {
+        column->indices.reserve(rows);
+    }
+    for (auto* column : {&tx_hash, &order_hash, &user, &taker}) {
+        column->offsets.reserve(rows + 1);
+    }
+    shares.reserve(rows);
+    shares_normalized.reserve(rows);
+    price.reserve(rows);
+    timestamp.reserve(rows);
+    taker_valid.reserve(rows);
+}
+
+void OrderColumnBatch::clear() {
+    for (auto* column : {&token_id, &token_label, &side, &market_slug, &condition_id, &title}) {
+        column->clear();
+    }
+    for (auto* column : {&tx_hash, &order_hash, &user, &taker}) {
+        column->clear();
+    }
+    shares.clear();
+    shares_normalized.clear();
+    price.clear();
+    timestamp.clear();
+    taker_valid.clear();
+}
+
+// ActivityColumnBatch
+
+void ActivityColumnBatch::append(const Activity& activity) {
+    token_id.append(activity.token_id);
+    side.append(activity.side);
+    market_slug.append(activity.market_slug);
+    condition_id.append(activity.condition_id);
+    title.append(activity.title);
+    shares.push_back(activity.shares);
+    shares_normalized.push_back(activity.shares_normalized.raw());
+    price.push_back(activity.price.raw());
+    tx_hash.append(activity.tx_hash);
+    timestamp.push_back(activity.timestamp);
+    order_hash.append(activity.order_hash);
+    user.append(activity.user);
+}
+
+void ActivityColumnBatch::reserve(size_t rows) {
+    for (auto* column : {&token_id, &side, &market_slug, &condition_id, &title}) {
+        column->indices.reserve(rows);
+    }
+    for (auto* column : {&tx_hash, &order_hash, &user}) {
+        column->offsets.reserve(rows + 1);
+    }
+    shares.reserve(rows);
+    shares_normalized.reserve(rows);
+    price.reserve(rows);
+    timestamp.reserve(rows);
+}
+
+void ActivityColumnBatch::clear() {
+    for (auto* column : {&token_id, &side, &market_slug, &condition_id, &title}) {
+        column->clear();
+    }
+    for (auto* column : {&tx_hash, &order_hash, &user}) {
+        column->clear();
+    }
+    shares.clear();
+    shares_normalized.clear();
+    price.clear();
+    timestamp.clear();
+}
+
+// Export drivers
+
+// Page through an endpoint, appending each record to a batch that is handed to
+// on_batch every batch_rows rows and once more at the end
+template<typename Batch, typename Params, typename Fetch, typename Page, typename Record, typename Callback>
+static size_t export_pages(Params params, Fetch&& fetch, std::vector<Record> Page::*records,
+                           const Callback& on_batch, const ColumnarExportOptions& options) {
+    Batch batch;
+    batch.reserve(options.batch_rows);
+
+    size_t exported = 0;
+    for_each_page(std::move(params), options.page_size, std::forward<Fetch>(fetch), records,
+                  [&](std::vector<Record>&& page) {
+                      for (const auto& record : page) {
+                          batch.append(record);
+                          if (batch.rows() >= options.batch_rows) {
+                              on_batch(batch);
+                              exported += batch.rows();
+                              batch.clear();
+                          }
+                      }
+                  });
+
+    if (batch.rows() > 0) {
+        on_batch(batch);
+        exported += batch.rows();
+    }
+    return exported;
+}
+
+size_t export_orders(OrdersEndpoints& endpoints,
+                     GetOrdersParams params,
+                     const OrderBatchCallback& on_batch,
+                     const ColumnarExportOptions& options) {
+    return export_pages<OrderColumnBatch>(
+        std::move(params), [&](const GetOrdersParams& page) { return endpoints.get_orders(page); },
+        &OrdersResponse::orders, on_batch, options);
+}
+
+size_t export_activity(ActivityEndpoints& endpoints,
+                       GetActivityParams params,
+                       const ActivityBatchCallback& on_batch,
+                       const ColumnarExportOptions& options) {
+    return export_pages<ActivityColumnBatch>(
+        std::move(params), [&](const GetActivityParams& page) { return endpoints.get_activity(page); },
+        &ActivityResponse::activities, on_batch, options);
+}
+
+}  // namespace dome
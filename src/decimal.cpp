@@ -0,0 +1,201 @@
+#include "dome_api_sdk/decimal.hpp"
+#include "dome_api_sdk/wide_int.hpp"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace dome {
+
+// A uint64 holds any 19-digit mantissa, which covers every int64 unit count
+static constexpr int kMaxSignificantDigits = 19;
+
+static constexpr uint64_t kPow10[] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+    1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+    100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+    1000000000000000000ull, 10000000000000000000ull,
+};
+
+static uint64_t magnitude_of(int64_t value) {
+    return value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+}
+
+// Apply a sign to a magnitude, returning false if the result does not fit an int64
+static bool signed_units(uint64_t magnitude, bool negative, int64_t& out) {
+    constexpr uint64_t kMax = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    if (magnitude > kMax + (negative ? 1 : 0)) {
+        return false;
+    }
+    out = negative && magnitude != 0 ? -static_cast<int64_t>(magnitude - 1) - 1 : static_cast<int64_t>(magnitude);
+    return true;
+}
+
+// Divide magnitudes rounding half up, returning false if the quotient does not fit 64 bits
+static bool divide_rounded(Uint128 numerator, uint64_t divisor, uint64_t& quotient) {
+    if (numerator.high >= divisor) {
+        return false;
+    }
+    uint64_t remainder = 0;
+    quotient = div_wide(numerator, divisor, remainder);
+    if (remainder >= divisor - remainder) {
+        if (quotient == std::numeric_limits<uint64_t>::max()) {
+            return false;
+        }
+        ++quotient;
+    }
+    return true;
+}
+
+Decimal Decimal::from_double(double value) {
+    double scaled = value * static_cast<double>(kOne);
+    if (!std::isfinite(scaled) || std::fabs(scaled) >= 9.2e18) {
+        throw std::out_of_range("Decimal out of range: " + std::to_string(value));
+    }
+    return Decimal(static_cast<int64_t>(std::llround(scaled)));
+}
+
+bool Decimal::try_parse(std::string_view text, Decimal& out) {
+    size_t i = 0;
+    size_t n = text.size();
+    while (i < n && text[i] == ' ') ++i;
+    while (n > i && text[n - 1] == ' ') --n;
+
+    bool negative = false;
+    if (i < n && (text[i] == '-' || text[i] == '+')) {
+        negative = text[i] == '-';
+        ++i;
+    }
+
+    uint64_t mantissa = 0;
+    int significant = 0;
+    int exponent = 0;
+    bool any_digit = false;
+    bool seen_point = false;
+    int first_dropped = -1;  // first digit past the precision limit, for rounding
+
+    for (; i < n; ++i) {
+        char c = text[i];
+        if (c >= '0' && c <= '9') {
+            any_digit = true;
+            if (mantissa == 0 && c == '0') {
+                // Leading zeros carry no precision
+                if (seen_point) --exponent;
+                continue;
+            }
+            if (significant < kMaxSignificantDigits) {
+                mantissa = mantissa * 10 + (c - '0');
+                ++significant;
+                if (seen_point) --exponent;
+            } else {
+                if (first_dropped < 0) first_dropped = c - '0';
+                if (!seen_point) ++exponent;  // Digits past the precision limit only scale the value
+            }
+        } else if (c == '.' && !seen_point) {
+            seen_point = true;
+        } else {
+            break;
+        }
+    }
+    if (!any_digit) {
+        return false;
+    }
+
+    if (i < n && (text[i] == 'e' || text[i] == 'E')) {
+        ++i;
+        bool exponent_negative = false;
+        if (i < n && (text[i] == '-' || text[i] == '+')) {
+            exponent_negative = text[i] == '-';
+            ++i;
+        }
+        int parsed = 0;
+        bool exponent_digit = false;
+        for (; i < n && text[i] >= '0' && text[i] <= '9'; ++i) {
+            exponent_digit = true;
+            if (parsed < 10000) parsed = parsed * 10 + (text[i] - '0');
+        }
+        if (!exponent_digit) {
+            return false;
+        }
+        exponent += exponent_negative ? -parsed : parsed;
+    }
+    if (i != n) {
+        return false;
+    }
+
+    int shift = exponent + kScale;
+    uint64_t units;
+    if (mantissa == 0) {
+        units = 0;
+    } else if (shift >= 0) {
+        if (shift + significant > 19) {
+            return false;
+        }
+        units = mantissa * kPow10[shift];
+        // Only with shift 0 can dropped digits fall below one unit
+        if (first_dropped >= 5) ++units;
+    } else if (-shift > 19) {
+        units = 0;
+    } else {
+        // Dropped digits cannot change the rounding: the divisor is even
+        uint64_t divisor = kPow10[-shift];
+        uint64_t remainder = mantissa % divisor;
+        units = mantissa / divisor + (remainder >= divisor - remainder ? 1 : 0);
+    }
+
+    int64_t value = 0;
+    if (!signed_units(units, negative, value)) {
+        return false;
+    }
+    out = Decimal(value);
+    return true;
+}
+
+Decimal Decimal::parse(std::string_view text) {
+    Decimal value;
+    if (!try_parse(text, value)) {
+        throw std::invalid_argument("Invalid decimal: " + std::string(text));
+    }
+    return value;
+}
+
+std::string Decimal::to_string() const {
+    uint64_t magnitude = units_ < 0 ? 0 - static_cast<uint64_t>(units_) : static_cast<uint64_t>(units_);
+    std::string result = units_ < 0 ? "-" : "";
+    result += std::to_string(magnitude / kOne);
+
+    uint64_t fraction = magnitude % kOne;
+    if (fraction != 0) {
+        std::string digits = std::to_string(fraction);
+        digits.insert(0, kScale - digits.size(), '0');
+        digits.erase(digits.find_last_not_of('0') + 1);
+        result += '.';
+        result += digits;
+    }
+    return result;
+}
+
+Decimal Decimal::operator*(Decimal other) const {
+    uint64_t magnitude = 0;
+    int64_t product = 0;
+    if (!divide_rounded(mul_wide(magnitude_of(units_), magnitude_of(other.units_)), kOne, magnitude) ||
+        !signed_units(magnitude, (units_ < 0) != (other.units_ < 0), product)) {
+        throw std::overflow_error("Decimal multiplication overflow");
+    }
+    return Decimal(product);
+}
+
+Decimal Decimal::operator/(Decimal other) const {
+    if (other.units_ == 0) {
+        throw std::domain_error("Decimal division by zero");
+    }
+    uint64_t magnitude = 0;
+    int64_t quotient = 0;
+    if (!divide_rounded(mul_wide(magnitude_of(units_), kOne), magnitude_of(other.units_), magnitude) ||
+        !signed_units(magnitude, (units_ < 0) != (other.units_ < 0), quotient)) {
+        throw std::overflow_error("Decimal division overflow");
+    }
+    return Decimal(quotient);
+}
+
+}  // namespace dome
@@ -0,0 +1,152 @@
+#include "dome_api_sdk/decode.hpp"
+
+namespace dome {
+
+// Read a string field as an identifier, sharing storage through the table if one is given
+static InternedString identifier_value(const nlohmann::json& item, const char* key,
+                                       InternTable* intern_table) {
+    auto it = item.find(key);
+    if (it == item.end() || !it->is_string()) {
+        return InternedString();
+    }
+    const auto& value = it->get_ref<const std::string&>();
+    return intern_table ? intern_table->intern(value) : InternedString(value);
+}
+
+// Read a decimal field from its text. nlohmann keeps JSON numbers as binary values, so
+// those are parsed from their shortest round-trip form, which is the text on the wire
+// for any value with up to 17 significant digits. Throws DomeAPIError on malformed
+// or out-of-range values.
+static Decimal decimal_value(const nlohmann::json& item, const char* key) {
+    auto it = item.find(key);
+    if (it == item.end() || it->is_null()) {
+        return Decimal();
+    }
+    Decimal value;
+    bool parsed = false;
+    if (it->is_string()) {
+        parsed = Decimal::try_parse(it->get_ref<const std::string&>(), value);
+    } else if (it->is_number()) {
+        parsed = Decimal::try_parse(it->dump(), value);
+    }
+    if (!parsed) {
+        throw DomeAPIError(-1, std::string("Invalid decimal in field '") + key + "': " + it->dump());
+    }
+    return value;
+}
+
+// Prefer the exact `<key>_dollars` text, falling back to the numeric field
+static Decimal dollars_value(const nlohmann::json& item, const std::string& key) {
+    std::string dollars_key = key + "_dollars";
+    if (item.contains(dollars_key)) {
+        return decimal_value(item, dollars_key.c_str());
+    }
+    return decimal_value(item, key.c_str());
+}
+
+// Normalized shares are raw / 1e6, which Decimal represents exactly
+static Decimal shares_normalized_value(const nlohmann::json& item, int64_t raw_shares) {
+    if (item.contains("shares_normalized")) {
+        return decimal_value(item, "shares_normalized");
+    }
+    return Decimal::from_raw(raw_shares);
+}
+
+static CandlestickAskBid decode_ask_bid(const nlohmann::json& item) {
+    CandlestickAskBid ask_bid;
+    ask_bid.open = dollars_value(item, "open");
+    ask_bid.close = dollars_value(item, "close");
+    ask_bid.high = dollars_value(item, "high");
+    ask_bid.low = dollars_value(item, "low");
+    return ask_bid;
+}
+
+static void decode_levels(const nlohmann::json& item, const char* key, std::vector<OrderbookLevel>& levels) {
+    auto it = item.find(key);
+    if (it == item.end() || !it->is_array()) {
+        return;
+    }
+    levels.reserve(it->size());
+    for (const auto& level : *it) {
+        levels.push_back({decimal_value(level, "price"), decimal_value(level, "size")});
+    }
+}
+
+Order decode_order(const nlohmann::json& item, InternTable* intern_table) {
+    Order order;
+    order.token_id = identifier_value(item, "token_id", intern_table);
+    order.token_label = identifier_value(item, "token_label", intern_table);
+    order.side = item.value("side", "");
+    order.market_slug = identifier_value(item, "market_slug", intern_table);
+    order.condition_id = identifier_value(item, "condition_id", intern_table);
+    order.shares = item.value("shares", 0LL);
+    order.shares_normalized = shares_normalized_value(item, order.shares);
+    order.price = decimal_value(item, "price");
+    order.tx_hash = item.value("tx_hash", "");
+    order.title = identifier_value(item, "title", intern_table);
+    order.timestamp = item.value("timestamp", 0LL);
+    order.order_hash = item.value("order_hash", "");
+    order.user = item.value("user", "");
+    if (item.contains("taker") && !item["taker"].is_null()) {
+        order.taker = item["taker"].get<std::string>();
+    }
+    return order;
+}
+
+Activity decode_activity(const nlohmann::json& item, InternTable* intern_table) {
+    Activity activity;
+    activity.token_id = identifier_value(item, "token_id", intern_table);
+    activity.side = item.value("side", "");
+    activity.market_slug = identifier_value(item, "market_slug", intern_table);
+    activity.condition_id = identifier_value(item, "condition_id", intern_table);
+    activity.shares = item.value("shares", 0LL);
+    activity.shares_normalized = shares_normalized_value(item, activity.shares);
+    activity.price = decimal_value(item, "price");
+    activity.tx_hash = item.value("tx_hash", "");
+    activity.title = identifier_value(item, "title", intern_table);
+    activity.timestamp = item.value("timestamp", 0LL);
+    activity.order_hash = item.value("order_hash", "");
+    activity.user = item.value("user", "");
+    return activity;
+}
+
+CandlestickData decode_candlestick(const nlohmann::json& item) {
+    CandlestickData candle;
+    candle.end_period_ts = item.value("end_period_ts", 0LL);
+    candle.open_interest = item.value("open_interest", 0LL);
+    candle.volume = item.value("volume", 0LL);
+
+    if (item.contains("price")) {
+        const auto& p = item["price"];
+        candle.price.open = dollars_value(p, "open");
+        candle.price.high = dollars_value(p, "high");
+        candle.price.low = dollars_value(p, "low");
+        candle.price.close = dollars_value(p, "close");
+        candle.price.mean = dollars_value(p, "mean");
+        candle.price.previous = dollars_value(p, "previous");
+    }
+    if (item.contains("yes_ask")) {
+        candle.yes_ask = decode_ask_bid(item["yes_ask"]);
+    }
+    if (item.contains("yes_bid")) {
+        candle.yes_bid = decode_ask_bid(item["yes_bid"]);
+    }
+    return candle;
+}
+
+OrderbookSnapshot decode_orderbook_snapshot(const nlohmann::json& item) {
+    OrderbookSnapshot snapshot;
+    snapshot.timestamp = item.value("timestamp", 0LL);
+    snapshot.hash = item.value("hash", "");
+    snapshot.minOrderSize = decimal_value(item, "minOrderSize");
+    snapshot.negRisk = item.value("negRisk", false);
+    snapshot.assetId = item.value("assetId", "");
+    snapshot.tickSize = decimal_value(item, "tickSize");
+    snapshot.indexedAt = item.value("indexedAt", 0LL);
+    snapshot.market = item.value("market", "");
+    decode_levels(item, "bids", snapshot.bids);
+    decode_levels(item, "asks", snapshot.asks);
+    return snapshot;
+}
+
+}  // namespace dome
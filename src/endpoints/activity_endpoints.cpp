@@ -1,13 +1,12 @@
 #include "dome_api_sdk/activity_endpoints.hpp"
+#include "dome_api_sdk/decode.hpp"
 
 namespace dome {
 
 ActivityEndpoints::ActivityEndpoints(const DomeSDKConfig& config)
     : BaseEndpoint(config) {}
 
-ActivityResponse ActivityEndpoints::get_activity(const GetActivityParams& params) {
-    std::string endpoint = "/polymarket/activity";
-    
+std::map<std::string, std::string> ActivityEndpoints::build_query(const GetActivityParams& params) {
     std::map<std::string, std::string> query_params;
     query_params["user"] = params.user;
     add_param_if_present(query_params, "start_time", params.start_time);
@@ -16,9 +15,23 @@ ActivityResponse ActivityEndpoints::get_activity(const GetActivityParams& params
     add_param_if_present(query_params, "condition_id", params.condition_id);
     add_param_if_present(query_params, "limit", params.limit);
     add_param_if_present(query_params, "offset", params.offset);
-    
-    auto json = http_client_->get(endpoint, query_params);
-    
+    return query_params;
+}
+
+ActivityResponse ActivityEndpoints::get_activity(const GetActivityParams& params, const RequestConfig& request_config) {
+    return parse_activity(http_client_->get("/polymarket/activity", build_query(params), request_config),
+                          config_.intern_table.get());
+}
+
+AsyncOp<ActivityResponse> ActivityEndpoints::get_activity_async(AsyncLoop& loop, const GetActivityParams& params,
+                                                                const RequestConfig& request_config) {
+    return http_client_->get_async(loop, "/polymarket/activity", build_query(params), request_config)
+        .map([intern_table = config_.intern_table](const nlohmann::json& json) {
+            return parse_activity(json, intern_table.get());
+        });
+}
+
+ActivityResponse ActivityEndpoints::parse_activity(const nlohmann::json& json, InternTable* intern_table) {
     ActivityResponse response;
     
     // Parse pagination
@@ -31,21 +44,10 @@ ActivityResponse ActivityEndpoints::get_activity(const GetActivityParams& params
     }
     
     if (json.contains("activities") && json["activities"].is_array()) {
-        for (const auto& item : json["activities"]) {
-            Activity activity;
-            activity.token_id = item.value("token_id", "");
-            activity.side = item.value("side", "");
-            activity.market_slug = item.value("market_slug", "");
-            activity.condition_id = item.value("condition_id", "");
-            activity.shares = item.value("shares", 0LL);
-            activity.shares_normalized = item.value("shares_normalized", 0.0);
-            activity.price = item.value("price", 0.0);
-            activity.tx_hash = item.value("tx_hash", "");
-            activity.title = item.value("title", "");
-            activity.timestamp = item.value("timestamp", 0LL);
-            activity.order_hash = item.value("order_hash", "");
-            activity.user = item.value("user", "");
-            response.activities.push_back(activity);
+        const auto& items = json["activities"];
+        response.activities.reserve(items.size());
+        for (const auto& item : items) {
+            response.activities.push_back(decode_activity(item, intern_table));
         }
     }
     
@@ -1,4 +1,5 @@
 #include "dome_api_sdk/dome_websocket.hpp"
+#include "dome_api_sdk/decode.hpp"
 #include <nlohmann/json.hpp>
 #include <iostream>
 
@@ -10,7 +11,7 @@ using json = nlohmann::json;
 static const std::string DOME_WS_BASE_URL = "wss://ws.domeapi.io/";
 
 DomeWebSocket::DomeWebSocket(const std::string& api_key)
-    : api_key_(api_key)
+    : api_key_(api_key), handlers_(std::make_shared<const Handlers>())
 {
     std::string url = DOME_WS_BASE_URL + api_key_;
     client_ = std::make_unique<WebSocketClient>(url);
@@ -21,30 +22,18 @@ DomeWebSocket::DomeWebSocket(const std::string& api_key)
     });
     
     client_->set_error_callback([this](const std::string& error) {
-        ErrorCallback cb;
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            cb = error_callback_;
-        }
-        if (cb) cb(error);
+        auto current = handlers();
+        if (current->error) current->error(error);
     });
     
     client_->set_connected_callback([this]() {
-        ConnectedCallback cb;
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            cb = connected_callback_;
-        }
-        if (cb) cb();
+        auto current = handlers();
+        if (current->connected) current->connected();
     });
     
     client_->set_disconnected_callback([this]() {
-        DisconnectedCallback cb;
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            cb = disconnected_callback_;
-        }
-        if (cb) cb();
+        auto current = handlers();
+        if (current->disconnected) current->disconnected();
     });
 }
 
@@ -124,32 +113,41 @@ void DomeWebSocket::on_message(const std::string& message) {
             handle_event_message(subscription_id, data_json);
         }
     } catch (const json::exception& e) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (error_callback_) {
-            error_callback_(std::string("JSON parse error: ") + e.what());
+        auto current = handlers();
+        if (current->error) {
+            current->error(std::string("JSON parse error: ") + e.what());
+        }
+    } catch (const std::exception& e) {
+        // Must not escape the WebSocket thread
+        auto current = handlers();
+        if (current->error) {
+            current->error(std::string("Message error: ") + e.what());
         }
     }
 }
 
 void DomeWebSocket::handle_ack_message(const std::string& subscription_id) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    // Store the subscription
-    ActiveSubscription sub;
-    sub.subscription_id = subscription_id;
-    sub.filters = pending_filters_;
-    sub.active = true;
-    subscriptions_[subscription_id] = sub;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // Store the subscription
+        ActiveSubscription sub;
+        sub.subscription_id = subscription_id;
+        sub.filters = pending_filters_;
+        sub.active = true;
+        subscriptions_[subscription_id] = sub;
+    }
     
-    if (ack_callback_) {
-        ack_callback_(subscription_id);
+    auto current = handlers();
+    if (current->ack) {
+        current->ack(subscription_id);
     }
 }
 
 void DomeWebSocket::handle_event_message(const std::string& subscription_id, const std::string& data_json) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    auto current = handlers();
     
-    if (!order_event_callback_) {
+    if (!current->order_event && !current->enriched_order_event) {
         return;
     }
     
@@ -160,28 +158,24 @@ void DomeWebSocket::handle_event_message(const std::string& subscription_id, con
         event.type = "event";
         event.subscription_id = subscription_id;
         
-        // Parse order data
-        event.data.token_id = data.value("token_id", "");
-        event.data.token_label = data.value("token_label", "");
-        event.data.side = data.value("side", "");
-        event.data.market_slug = data.value("market_slug", "");
-        event.data.condition_id = data.value("condition_id", "");
-        event.data.shares = data.value("shares", 0.0f);
-        event.data.shares_normalized = data.value("shares_normalized", 0.0);
-        event.data.price = data.value("price", 0.0);
-        event.data.tx_hash = data.value("tx_hash", "");
-        event.data.title = data.value("title", "");
-        event.data.timestamp = data.value("timestamp", 0LL);
-        event.data.order_hash = data.value("order_hash", "");
-        event.data.user = data.value("user", "");
-        if (data.contains("taker") && !data["taker"].is_null()) {
-            event.data.taker = data.value("taker", "");
-        }
+        event.data = decode_order(data, current->intern_table.get());
         
-        order_event_callback_(event);
+        if (current->order_event) {
+            current->order_event(event);
+        }
+        if (current->enriched_order_event) {
+            const TokenIndex* index = current->token_index.get();
+            TokenMatch match = index ? index->find(event.data.token_id.str()) : TokenMatch();
+            current->enriched_order_event(event, match);
+        }
     } catch (const json::exception& e) {
-        if (error_callback_) {
-            error_callback_(std::string("Event parse error: ") + e.what());
+        if (current->error) {
+            current->error(std::string("Event parse error: ") + e.what());
+        }
+    } catch (const std::exception& e) {
+        // E.g. a malformed price or shares value rejected by the decoder
+        if (current->error) {
+            current->error(std::string("Event decode error: ") + e.what());
         }
     }
 }
@@ -218,32 +212,51 @@ std::string DomeWebSocket::build_unsubscribe_message(const std::string& subscrip
     return msg.dump();
 }
 
-void DomeWebSocket::set_order_event_callback(OrderEventCallback callback) {
+std::shared_ptr<const DomeWebSocket::Handlers> DomeWebSocket::handlers() const {
+    return std::atomic_load(&handlers_);
+}
+
+void DomeWebSocket::update_handlers(const std::function<void(Handlers&)>& update) {
     std::lock_guard<std::mutex> lock(mutex_);
-    order_event_callback_ = std::move(callback);
+    auto next = std::make_shared<Handlers>(*handlers_);
+    update(*next);
+    std::atomic_store(&handlers_, std::shared_ptr<const Handlers>(std::move(next)));
+}
+
+void DomeWebSocket::set_order_event_callback(OrderEventCallback callback) {
+    update_handlers([&](Handlers& h) { h.order_event = std::move(callback); });
+}
+
+void DomeWebSocket::set_enriched_order_event_callback(EnrichedOrderEventCallback callback) {
+    update_handlers([&](Handlers& h) { h.enriched_order_event = std::move(callback); });
 }
 
 void DomeWebSocket::set_ack_callback(AckCallback callback) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    ack_callback_ = std::move(callback);
+    update_handlers([&](Handlers& h) { h.ack = std::move(callback); });
 }
 
 void DomeWebSocket::set_error_callback(ErrorCallback callback) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    error_callback_ = std::move(callback);
+    update_handlers([&](Handlers& h) { h.error = std::move(callback); });
 }
 
 void DomeWebSocket::set_connected_callback(ConnectedCallback callback) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    connected_callback_ = std::move(callback);
+    update_handlers([&](Handlers& h) { h.connected = std::move(callback); });
 }
 
 void DomeWebSocket::set_disconnected_callback(DisconnectedCallback callback) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    disconnected_callback_ = std::move(callback);
+    update_handlers([&](Handlers& h) { h.disconnected = std::move(callback); });
+}
+
+void DomeWebSocket::set_intern_table(std::shared_ptr<InternTable> intern_table) {
+    update_handlers([&](Handlers& h) { h.intern_table = std::move(intern_table); });
+}
+
+void DomeWebSocket::set_token_index(std::shared_ptr<const TokenIndex> token_index) {
+    update_handlers([&](Handlers& h) { h.token_index = std::move(token_index); });
 }
 
-const std::map<std::string, ActiveSubscription>& DomeWebSocket::get_subscriptions() const {
+std::map<std::string, ActiveSubscription> DomeWebSocket::get_subscriptions() const {
+    std::lock_guard<std::mutex> lock(mutex_);
     return subscriptions_;
 }
 
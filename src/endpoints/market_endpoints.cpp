@@ -1,83 +1,129 @@
 #include "dome_api_sdk/market_endpoints.hpp"
+#include "dome_api_sdk/decode.hpp"
+
+#include <charconv>
 
 namespace dome {
 
 MarketEndpoints::MarketEndpoints(const DomeSDKConfig& config)
     : BaseEndpoint(config) {}
 
-MarketPriceResponse MarketEndpoints::get_market_price(const GetMarketPriceParams& params) {
-    std::string endpoint = "/polymarket/market-price/" + params.token_id;
-    
-    std::map<std::string, std::string> query_params;
-    add_param_if_present(query_params, "at_time", params.at_time);
-    
-    auto json = http_client_->get(endpoint, query_params);
-    
+static MarketPriceResponse parse_market_price(const nlohmann::json& json) {
     MarketPriceResponse response;
     response.price = json.value("price", 0.0);
     response.at_time = json.value("at_time", 0LL);
-    
     return response;
 }
 
-CandlesticksResponse MarketEndpoints::get_candlesticks(const GetCandlesticksParams& params) {
-    std::string endpoint = "/polymarket/candlesticks/" + params.condition_id;
-    
-    std::map<std::string, std::string> query_params;
-    query_params["start_time"] = std::to_string(params.start_time);
-    query_params["end_time"] = std::to_string(params.end_time);
+BatchRequest MarketEndpoints::make_market_price_request(const GetMarketPriceParams& params) {
+    BatchRequest request;
+    request.endpoint = "/polymarket/market-price/" + params.token_id;
+    add_param_if_present(request.query_params, "at_time", params.at_time);
+    return request;
+}
+
+MarketPriceResponse MarketEndpoints::get_market_price(const GetMarketPriceParams& params,
+                                                      const RequestConfig& request_config) {
+    BatchRequest request = make_market_price_request(params);
+    return parse_market_price(http_client_->get(request.endpoint, request.query_params, request_config));
+}
+
+AsyncOp<MarketPriceResponse> MarketEndpoints::get_market_price_async(AsyncLoop& loop,
+                                                                     const GetMarketPriceParams& params,
+                                                                     const RequestConfig& request_config) {
+    BatchRequest request = make_market_price_request(params);
+    return http_client_->get_async(loop, request.endpoint, request.query_params, request_config)
+        .map(&parse_market_price);
+}
+
+PreparedMarketPrice MarketEndpoints::prepare_market_price() const {
+    return PreparedMarketPrice(http_client_->prepare("/polymarket/market-price/"));
+}
+
+MarketPriceResponse PreparedMarketPrice::get(const GetMarketPriceParams& params, const RequestConfig& request_config) {
+    nlohmann::json json;
+    if (params.at_time.has_value()) {
+        char at_time[24];
+        auto end = std::to_chars(at_time, at_time + sizeof(at_time), *params.at_time).ptr;
+        json = request_.get(params.token_id, {{"at_time", std::string_view(at_time, end - at_time)}}, request_config);
+    } else {
+        json = request_.get(params.token_id, {}, request_config);
+    }
+    return parse_market_price(json);
+}
+
+BatchRequest MarketEndpoints::make_candlesticks_request(const GetCandlesticksParams& params) {
+    BatchRequest request;
+    request.endpoint = "/polymarket/candlesticks/" + params.condition_id;
+    request.query_params["start_time"] = std::to_string(params.start_time);
+    request.query_params["end_time"] = std::to_string(params.end_time);
     if (params.interval.has_value()) {
-        query_params["interval"] = std::to_string(params.interval.value());
+        request.query_params["interval"] = std::to_string(params.interval.value());
     }
-    
-    auto json = http_client_->get(endpoint, query_params);
-    
+    return request;
+}
+
+CandlesticksResponse MarketEndpoints::get_candlesticks(const GetCandlesticksParams& params,
+                                                       const RequestConfig& request_config) {
+    BatchRequest request = make_candlesticks_request(params);
+    return parse_candlesticks(http_client_->get(request.endpoint, request.query_params, request_config));
+}
+
+AsyncOp<CandlesticksResponse> MarketEndpoints::get_candlesticks_async(AsyncLoop& loop,
+                                                                      const GetCandlesticksParams& params,
+                                                                      const RequestConfig& request_config) {
+    BatchRequest request = make_candlesticks_request(params);
+    return http_client_->get_async(loop, request.endpoint, request.query_params, request_config)
+        .map([](const nlohmann::json& json) { return parse_candlesticks(json); });
+}
+
+CandlesticksResponse MarketEndpoints::parse_candlesticks(const nlohmann::json& json) {
     CandlesticksResponse response;
     
     if (json.contains("candlesticks") && json["candlesticks"].is_array()) {
-        for (const auto& item : json["candlesticks"]) {
-            CandlestickData candle;
-            candle.end_period_ts = item.value("end_period_ts", 0LL);
-            candle.open_interest = item.value("open_interest", 0LL);
-            candle.volume = item.value("volume", 0LL);
-            
-            // Parse price
-            if (item.contains("price")) {
-                const auto& p = item["price"];
-                candle.price.open = p.value("open", 0.0);
-                candle.price.high = p.value("high", 0.0);
-                candle.price.low = p.value("low", 0.0);
-                candle.price.close = p.value("close", 0.0);
-                candle.price.open_dollars = p.value("open_dollars", "");
-                candle.price.high_dollars = p.value("high_dollars", "");
-                candle.price.low_dollars = p.value("low_dollars", "");
-                candle.price.close_dollars = p.value("close_dollars", "");
-                candle.price.mean = p.value("mean", 0.0);
-                candle.price.mean_dollars = p.value("mean_dollars", "");
-                candle.price.previous = p.value("previous", 0.0);
-                candle.price.previous_dollars = p.value("previous_dollars", "");
-            }
-            
-            response.candlesticks.push_back(candle);
+        const auto& items = json["candlesticks"];
+        response.candlesticks.reserve(items.size());
+        for (const auto& item : items) {
+            response.candlesticks.push_back(decode_candlestick(item));
         }
     }
     
     return response;
 }
 
-MarketsResponse MarketEndpoints::get_markets(const GetMarketsParams& params) {
-    std::string endpoint = "/polymarket/markets";
-    
-    std::map<std::string, std::string> query_params;
-    add_param_if_present(query_params, "status", params.status);
-    add_param_if_present(query_params, "limit", params.limit);
-    add_param_if_present(query_params, "offset", params.offset);
-    add_param_if_present(query_params, "min_volume", params.min_volume);
-    add_param_if_present(query_params, "market_slug", params.market_slug);
-    add_param_if_present(query_params, "tags", params.tags);
-    
-    auto json = http_client_->get(endpoint, query_params);
-    
+BatchRequest MarketEndpoints::make_markets_request(const GetMarketsParams& params) {
+    BatchRequest request;
+    request.endpoint = "/polymarket/markets";
+    add_param_if_present(request.query_params, "status", params.status);
+    add_param_if_present(request.query_params, "limit", params.limit);
+    add_param_if_present(request.query_params, "offset", params.offset);
+    add_param_if_present(request.query_params, "min_volume", params.min_volume);
+    // Several slugs go as one comma-separated market_slug
+    std::optional<std::vector<std::string>> slugs = params.market_slugs;
+    if (params.market_slug.has_value()) {
+        if (!slugs.has_value()) slugs.emplace();
+        slugs->insert(slugs->begin(), *params.market_slug);
+    }
+    add_param_if_present(request.query_params, "market_slug", slugs);
+    add_param_if_present(request.query_params, "event_slug", params.event_slug);
+    add_param_if_present(request.query_params, "condition_id", params.condition_id);
+    add_param_if_present(request.query_params, "tags", params.tags);
+    return request;
+}
+
+MarketsResponse MarketEndpoints::get_markets(const GetMarketsParams& params, const RequestConfig& request_config) {
+    BatchRequest request = make_markets_request(params);
+    return parse_markets(http_client_->get(request.endpoint, request.query_params, request_config));
+}
+
+AsyncOp<MarketsResponse> MarketEndpoints::get_markets_async(AsyncLoop& loop, const GetMarketsParams& params,
+                                                            const RequestConfig& request_config) {
+    BatchRequest request = make_markets_request(params);
+    return http_client_->get_async(loop, request.endpoint, request.query_params, request_config)
+        .map([](const nlohmann::json& json) { return parse_markets(json); });
+}
+
+MarketsResponse MarketEndpoints::parse_markets(const nlohmann::json& json) {
     MarketsResponse response;
     
     // Parse pagination
@@ -90,7 +136,9 @@ MarketsResponse MarketEndpoints::get_markets(const GetMarketsParams& params) {
     }
     
     if (json.contains("markets") && json["markets"].is_array()) {
-        for (const auto& item : json["markets"]) {
+        const auto& items = json["markets"];
+        response.markets.reserve(items.size());
+        for (const auto& item : items) {
             Market market;
             market.market_slug = item.value("market_slug", "");
             market.condition_id = item.value("condition_id", "");
@@ -118,77 +166,79 @@ MarketsResponse MarketEndpoints::get_markets(const GetMarketsParams& params) {
             }
             
             if (item.contains("tags") && item["tags"].is_array()) {
+                market.tags.reserve(item["tags"].size());
                 for (const auto& tag : item["tags"]) {
                     market.tags.push_back(tag.get<std::string>());
                 }
             }
             
-            response.markets.push_back(market);
+            response.markets.push_back(std::move(market));
         }
     }
     
     return response;
 }
 
-OrderbooksResponse MarketEndpoints::get_orderbooks(const GetOrderbooksParams& params) {
-    std::string endpoint = "/polymarket/orderbooks";
-    
+static OrderbookPagination decode_orderbook_pagination(const nlohmann::json& json) {
+    OrderbookPagination pagination{};
+    if (json.contains("pagination")) {
+        const auto& p = json["pagination"];
+        pagination.limit = p.value("limit", 0);
+        pagination.count = p.value("count", 0);
+        pagination.has_more = p.value("has_more", false);
+        if (p.contains("pagination_key") && !p["pagination_key"].is_null()) {
+            pagination.pagination_key = p["pagination_key"].get<std::string>();
+        }
+    }
+    return pagination;
+}
+
+std::map<std::string, std::string> MarketEndpoints::build_orderbooks_query(const GetOrderbooksParams& params) {
     std::map<std::string, std::string> query_params;
     query_params["token_id"] = params.token_id;
     query_params["start_time"] = std::to_string(params.start_time);
     query_params["end_time"] = std::to_string(params.end_time);
     add_param_if_present(query_params, "limit", params.limit);
-    
-    auto json = http_client_->get(endpoint, query_params);
-    
+    return query_params;
+}
+
+OrderbooksResponse MarketEndpoints::get_orderbooks(const GetOrderbooksParams& params,
+                                                   const RequestConfig& request_config) {
+    return parse_orderbooks(
+        http_client_->get("/polymarket/orderbooks", build_orderbooks_query(params), request_config));
+}
+
+AsyncOp<OrderbooksResponse> MarketEndpoints::get_orderbooks_async(AsyncLoop& loop,
+                                                                  const GetOrderbooksParams& params,
+                                                                  const RequestConfig& request_config) {
+    return http_client_->get_async(loop, "/polymarket/orderbooks", build_orderbooks_query(params), request_config)
+        .map([](const nlohmann::json& json) { return parse_orderbooks(json); });
+}
+
+OrderbooksResponse MarketEndpoints::parse_orderbooks(const nlohmann::json& json) {
     OrderbooksResponse response;
-    
-    // Parse pagination
-    if (json.contains("pagination")) {
-        const auto& p = json["pagination"];
-        response.pagination.limit = p.value("limit", 0);
-        response.pagination.count = p.value("count", 0);
-        response.pagination.has_more = p.value("has_more", false);
-        if (p.contains("pagination_key") && !p["pagination_key"].is_null()) {
-            response.pagination.pagination_key = p["pagination_key"].get<std::string>();
-        }
-    }
+    response.pagination = decode_orderbook_pagination(json);
     
     if (json.contains("snapshots") && json["snapshots"].is_array()) {
-        for (const auto& item : json["snapshots"]) {
-            OrderbookSnapshot snapshot;
-            snapshot.timestamp = item.value("timestamp", 0LL);
-            snapshot.hash = item.value("hash", "");
-            snapshot.minOrderSize = item.value("minOrderSize", "");
-            snapshot.negRisk = item.value("negRisk", false);
-            snapshot.assetId = item.value("assetId", "");
-            snapshot.tickSize = item.value("tickSize", "");
-            snapshot.indexedAt = item.value("indexedAt", 0LL);
-            snapshot.market = item.value("market", "");
-            
-            if (item.contains("bids") && item["bids"].is_array()) {
-                for (const auto& bid : item["bids"]) {
-                    std::map<std::string, std::string> level;
-                    level["price"] = bid.value("price", "");
-                    level["size"] = bid.value("size", "");
-                    snapshot.bids.push_back(level);
-                }
-            }
-            
-            if (item.contains("asks") && item["asks"].is_array()) {
-                for (const auto& ask : item["asks"]) {
-                    std::map<std::string, std::string> level;
-                    level["price"] = ask.value("price", "");
-                    level["size"] = ask.value("size", "");
-                    snapshot.asks.push_back(level);
-                }
-            }
-            
-            response.snapshots.push_back(snapshot);
+        const auto& items = json["snapshots"];
+        response.snapshots.reserve(items.size());
+        for (const auto& item : items) {
+            response.snapshots.push_back(decode_orderbook_snapshot(item));
         }
     }
     
     return response;
 }
 
+OrderbookPagination MarketEndpoints::stream_orderbooks(const GetOrderbooksParams& params,
+                                                       const std::function<void(const OrderbookSnapshot&)>& on_snapshot,
+                                                       const RequestConfig& request_config) {
+    auto rest = http_client_->get_streaming("/polymarket/orderbooks", build_orderbooks_query(params), "snapshots",
+                                            [&](const nlohmann::json& item) {
+                                                on_snapshot(decode_orderbook_snapshot(item));
+                                            },
+                                            request_config);
+    return decode_orderbook_pagination(rest);
+}
+
 }  // namespace dome
\ No newline at end of file
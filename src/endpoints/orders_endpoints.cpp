@@ -1,13 +1,26 @@
 #include "dome_api_sdk/orders_endpoints.hpp"
+#include "dome_api_sdk/decode.hpp"
+
+#include <algorithm>
 
 namespace dome {
 
 OrdersEndpoints::OrdersEndpoints(const DomeSDKConfig& config)
     : BaseEndpoint(config) {}
 
-OrdersResponse OrdersEndpoints::get_orders(const GetOrdersParams& params) {
-    std::string endpoint = "/polymarket/orders";
-    
+static Pagination decode_pagination(const nlohmann::json& json) {
+    Pagination pagination{};
+    if (json.contains("pagination")) {
+        const auto& p = json["pagination"];
+        pagination.total = p.value("total", 0);
+        pagination.limit = p.value("limit", 0);
+        pagination.offset = p.value("offset", 0);
+        pagination.has_more = p.value("has_more", false);
+    }
+    return pagination;
+}
+
+std::map<std::string, std::string> OrdersEndpoints::build_query(const GetOrdersParams& params) {
     std::map<std::string, std::string> query_params;
     add_param_if_present(query_params, "market_slug", params.market_slug);
     add_param_if_present(query_params, "market_slugs", params.market_slugs);
@@ -18,44 +31,194 @@ OrdersResponse OrdersEndpoints::get_orders(const GetOrdersParams& params) {
     add_param_if_present(query_params, "offset", params.offset);
     add_param_if_present(query_params, "start_time", params.start_time);
     add_param_if_present(query_params, "end_time", params.end_time);
-    
-    auto json = http_client_->get(endpoint, query_params);
-    
+    return query_params;
+}
+
+OrdersResponse OrdersEndpoints::get_orders(const GetOrdersParams& params, const RequestConfig& request_config) {
+    return parse_orders(http_client_->get("/polymarket/orders", build_query(params), request_config),
+                        config_.intern_table.get());
+}
+
+AsyncOp<OrdersResponse> OrdersEndpoints::get_orders_async(AsyncLoop& loop, const GetOrdersParams& params,
+                                                          const RequestConfig& request_config) {
+    return http_client_->get_async(loop, "/polymarket/orders", build_query(params), request_config)
+        .map([intern_table = config_.intern_table](const nlohmann::json& json) {
+            return parse_orders(json, intern_table.get());
+        });
+}
+
+OrdersResponse OrdersEndpoints::parse_orders(const nlohmann::json& json, InternTable* intern_table) {
     OrdersResponse response;
-    
-    // Parse pagination
-    if (json.contains("pagination")) {
-        const auto& p = json["pagination"];
-        response.pagination.total = p.value("total", 0);
-        response.pagination.limit = p.value("limit", 0);
-        response.pagination.offset = p.value("offset", 0);
-        response.pagination.has_more = p.value("has_more", false);
-    }
+    response.pagination = decode_pagination(json);
     
     if (json.contains("orders") && json["orders"].is_array()) {
-        for (const auto& item : json["orders"]) {
-            Order order;
-            order.token_id = item.value("token_id", "");
-            order.token_label = item.value("token_label", "");
-            order.side = item.value("side", "");
-            order.market_slug = item.value("market_slug", "");
-            order.condition_id = item.value("condition_id", "");
-            order.shares = item.value("shares", 0LL);
-            order.shares_normalized = item.value("shares_normalized", 0.0);
-            order.price = item.value("price", 0.0);
-            order.tx_hash = item.value("tx_hash", "");
-            order.title = item.value("title", "");
-            order.timestamp = item.value("timestamp", 0LL);
-            order.order_hash = item.value("order_hash", "");
-            order.user = item.value("user", "");
-            if (item.contains("taker") && !item["taker"].is_null()) {
-                order.taker = item["taker"].get<std::string>();
-            }
-            response.orders.push_back(order);
+        const auto& items = json["orders"];
+        response.orders.reserve(items.size());
+        for (const auto& item : items) {
+            response.orders.push_back(decode_order(item, intern_table));
         }
     }
     
     return response;
 }
 
+Pagination OrdersEndpoints::stream_orders(const GetOrdersParams& params,
+                                         const std::function<void(const Order&)>& on_order,
+                                         const RequestConfig& request_config) {
+    InternTable* intern_table = config_.intern_table.get();
+    auto rest = http_client_->get_streaming("/polymarket/orders", build_query(params), "orders",
+                                            [&](const nlohmann::json& item) {
+                                                on_order(decode_order(item, intern_table));
+                                            },
+                                            request_config);
+    return decode_pagination(rest);
+}
+
+// Decodes an orders body into an OrdersArenaPage straight from the parser's events:
+// no JSON document is built, and each string is copied once, into the arena
+class OrdersArenaSax : public nlohmann::json_sax<nlohmann::json> {
+public:
+    explicit OrdersArenaSax(OrdersArenaPage& page) : page_(page) {}
+
+    bool null() override { return true; }
+    bool boolean(bool v) override {
+        if (in_pagination() && key_ == "has_more") {
+            page_.pagination.has_more = v;
+        }
+        return true;
+    }
+    bool number_integer(number_integer_t v) override { return number(v, std::to_string(v)); }
+    bool number_unsigned(number_unsigned_t v) override {
+        return number(static_cast<int64_t>(v), std::to_string(v));
+    }
+    bool number_float(number_float_t v, const string_t& text) override {
+        return number(static_cast<int64_t>(v), text);
+    }
+    bool string(string_t& v) override {
+        if (!in_record()) {
+            return true;
+        }
+        ArenaOrder& order = page_.orders.back();
+        if (std::pmr::string ArenaOrder::*field = string_field(key_)) {
+            (order.*field).assign(v);
+        } else if (key_ == "price") {
+            order.price = decimal(v);
+        } else if (key_ == "shares_normalized") {
+            order.shares_normalized = decimal(v);
+            has_normalized_ = true;
+        }
+        return true;
+    }
+    bool binary(binary_t&) override { return true; }
+
+    bool start_object(std::size_t) override {
+        if (in_orders_ && depth_ == 2) {
+            page_.orders.emplace_back();
+            has_normalized_ = false;
+        }
+        ++depth_;
+        return true;
+    }
+    bool end_object() override {
+        if (in_record() && !has_normalized_) {
+            ArenaOrder& order = page_.orders.back();
+            order.shares_normalized = Decimal::from_raw(order.shares);
+        }
+        --depth_;
+        return true;
+    }
+    bool start_array(std::size_t) override {
+        if (depth_ == 1 && key_ == "orders") {
+            in_orders_ = true;
+        }
+        ++depth_;
+        return true;
+    }
+    bool end_array() override {
+        if (--depth_ == 1) {
+            in_orders_ = false;
+        }
+        return true;
+    }
+    bool key(string_t& k) override {
+        if (depth_ == 1) {
+            section_.assign(k);
+        }
+        key_.assign(k);
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) override {
+        throw DomeAPIError(-1, std::string("JSON parse error: ") + e.what());
+    }
+
+private:
+    bool in_record() const { return in_orders_ && depth_ == 3; }
+    bool in_pagination() const { return !in_orders_ && depth_ == 2 && section_ == "pagination"; }
+
+    static std::pmr::string ArenaOrder::*string_field(const std::string& key) {
+        static const std::pair<const char*, std::pmr::string ArenaOrder::*> fields[] = {
+            {"token_id", &ArenaOrder::token_id}, {"token_label", &ArenaOrder::token_label},
+            {"side", &ArenaOrder::side}, {"market_slug", &ArenaOrder::market_slug},
+            {"condition_id", &ArenaOrder::condition_id}, {"tx_hash", &ArenaOrder::tx_hash},
+            {"title", &ArenaOrder::title}, {"order_hash", &ArenaOrder::order_hash},
+            {"user", &ArenaOrder::user}, {"taker", &ArenaOrder::taker},
+        };
+        for (const auto& [name, field] : fields) {
+            if (key == name) {
+                return field;
+            }
+        }
+        return nullptr;
+    }
+
+    Decimal decimal(std::string_view text) const {
+        Decimal value;
+        if (!Decimal::try_parse(text, value)) {
+            throw DomeAPIError(-1, "Invalid decimal in field '" + key_ + "': " + std::string(text));
+        }
+        return value;
+    }
+
+    bool number(int64_t value, std::string_view text) {
+        if (in_record()) {
+            ArenaOrder& order = page_.orders.back();
+            if (key_ == "shares") {
+                order.shares = value;
+            } else if (key_ == "timestamp") {
+                order.timestamp = value;
+            } else if (key_ == "price") {
+                order.price = decimal(text);
+            } else if (key_ == "shares_normalized") {
+                order.shares_normalized = decimal(text);
+                has_normalized_ = true;
+            }
+        } else if (in_pagination()) {
+            if (key_ == "total") {
+                page_.pagination.total = static_cast<int>(value);
+            } else if (key_ == "limit") {
+                page_.pagination.limit = static_cast<int>(value);
+            } else if (key_ == "offset") {
+                page_.pagination.offset = static_cast<int>(value);
+            }
+        }
+        return true;
+    }
+
+    OrdersArenaPage& page_;
+    std::string key_;
+    std::string section_;  // top-level key the current value belongs to
+    int depth_ = 0;
+    bool in_orders_ = false;
+    bool has_normalized_ = false;
+};
+
+void OrdersEndpoints::get_orders_into(const GetOrdersParams& params, OrdersArenaPage& page,
+                                      const RequestConfig& request_config) {
+    page.clear();
+    page.orders.reserve(static_cast<size_t>(std::clamp(params.limit.value_or(100), 1, 1000)));
+    OrdersArenaSax sax(page);
+    http_client_->get_sax("/polymarket/orders", build_query(params), sax, request_config);
+}
+
 }  // namespace dome
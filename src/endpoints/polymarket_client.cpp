@@ -1,5 +1,6 @@
 #include "dome_api_sdk/polymarket_client.hpp"
 #include <cstdlib>
+#include <algorithm>
 
 namespace dome {
 
@@ -12,11 +13,30 @@ std::string PolymarketClient::resolve_api_key(const DomeSDKConfig& config) {
     return (env_key != nullptr) ? std::string(env_key) : "";
 }
 
+DomeSDKConfig PolymarketClient::with_connection_pool(const DomeSDKConfig& config) {
+    DomeSDKConfig shared = config;
+    if (!shared.connection_pool) {
+        shared.connection_pool = std::make_shared<ConnectionPool>();
+    }
+    return shared;
+}
+
 PolymarketClient::PolymarketClient(const DomeSDKConfig& config)
-    : config_(config),
-      markets(config),
-      orders(config),
-      wallet(config),
-      activity(config) {}
+    : config_(with_connection_pool(config)),
+      markets(config_),
+      orders(config_),
+      wallet(config_),
+      activity(config_) {
+    if (config_.warmup_connections > 0) {
+        warmup(config_.warmup_connections);
+    }
+    if (config_.keepalive_interval > 0) {
+        markets.http_client_->start_keepalive(std::chrono::seconds(config_.keepalive_interval));
+    }
+}
+
+size_t PolymarketClient::warmup(size_t connections) {
+    return markets.http_client_->warmup(connections);
+}
 
 }  // namespace dome
\ No newline at end of file
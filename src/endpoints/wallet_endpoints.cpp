@@ -1,20 +1,24 @@
 #include "dome_api_sdk/wallet_endpoints.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace dome {
 
 WalletEndpoints::WalletEndpoints(const DomeSDKConfig& config)
     : BaseEndpoint(config) {}
 
-WalletPnLResponse WalletEndpoints::get_wallet_pnl(const GetWalletPnLParams& params) {
-    std::string endpoint = "/polymarket/wallet/pnl/" + params.wallet_address;
-    
-    std::map<std::string, std::string> query_params;
-    query_params["granularity"] = granularity_to_string(params.granularity);
-    add_param_if_present(query_params, "start_time", params.start_time);
-    add_param_if_present(query_params, "end_time", params.end_time);
-    
-    auto json = http_client_->get(endpoint, query_params);
-    
+BatchRequest WalletEndpoints::make_request(const GetWalletPnLParams& params) {
+    BatchRequest request;
+    request.endpoint = "/polymarket/wallet/pnl/" + params.wallet_address;
+    request.query_params["granularity"] = granularity_to_string(params.granularity);
+    add_param_if_present(request.query_params, "start_time", params.start_time);
+    add_param_if_present(request.query_params, "end_time", params.end_time);
+    return request;
+}
+
+WalletPnLResponse WalletEndpoints::parse_response(const nlohmann::json& json) {
     WalletPnLResponse response;
     response.granularity = json.value("granularity", "");
     response.start_time = json.value("start_time", 0LL);
@@ -22,7 +26,9 @@ WalletPnLResponse WalletEndpoints::get_wallet_pnl(const GetWalletPnLParams& para
     response.wallet_address = json.value("wallet_address", "");
     
     if (json.contains("pnl_over_time") && json["pnl_over_time"].is_array()) {
-        for (const auto& item : json["pnl_over_time"]) {
+        const auto& items = json["pnl_over_time"];
+        response.pnl_over_time.reserve(items.size());
+        for (const auto& item : items) {
             PnLDataPoint point;
             point.timestamp = item.value("timestamp", 0LL);
             point.pnl_to_date = item.value("pnl_to_date", 0.0);
@@ -33,4 +39,79 @@ WalletPnLResponse WalletEndpoints::get_wallet_pnl(const GetWalletPnLParams& para
     return response;
 }
 
+WalletPnLResponse WalletEndpoints::get_wallet_pnl(const GetWalletPnLParams& params, const RequestConfig& request_config) {
+    BatchRequest request = make_request(params);
+    auto json = http_client_->get(request.endpoint, request.query_params, request_config);
+    return parse_response(json);
+}
+
+AsyncOp<WalletPnLResponse> WalletEndpoints::get_wallet_pnl_async(AsyncLoop& loop, const GetWalletPnLParams& params,
+                                                                  const RequestConfig& request_config) {
+    BatchRequest request = make_request(params);
+    return http_client_->get_async(loop, request.endpoint, request.query_params, request_config)
+        .map([](const nlohmann::json& json) { return parse_response(json); });
+}
+
+WalletPnLMatrix WalletEndpoints::get_wallet_pnl_bulk(const std::vector<GetWalletPnLParams>& params,
+                                                     const BulkPnLOptions& options,
+                                                     const RequestConfig& request_config) {
+    std::vector<BatchRequest> requests;
+    requests.reserve(params.size());
+    for (const auto& p : params) {
+        requests.push_back(make_request(p));
+    }
+
+    BatchOptions batch_options;
+    batch_options.max_concurrency = options.max_concurrency;
+    batch_options.requests_per_second = options.requests_per_second;
+    auto results = http_client_->get_many(requests, batch_options, request_config);
+
+    WalletPnLMatrix matrix;
+    std::vector<WalletPnLResponse> responses;
+    responses.reserve(results.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (results[i].error.has_value()) {
+            const DomeAPIError& error = *results[i].error;
+            matrix.errors.push_back({params[i].wallet_address, error.status_code, error.what()});
+            continue;
+        }
+        try {
+            responses.push_back(parse_response(results[i].body));
+        } catch (const nlohmann::json::exception& e) {
+            matrix.errors.push_back({params[i].wallet_address, -1, e.what()});
+            continue;
+        }
+        matrix.wallets.push_back(params[i].wallet_address);
+    }
+
+    // Columns are the union of every wallet's timestamps
+    for (const auto& response : responses) {
+        for (const auto& point : response.pnl_over_time) {
+            matrix.timestamps.push_back(point.timestamp);
+        }
+    }
+    std::sort(matrix.timestamps.begin(), matrix.timestamps.end());
+    matrix.timestamps.erase(std::unique(matrix.timestamps.begin(), matrix.timestamps.end()),
+                            matrix.timestamps.end());
+
+    const size_t columns = matrix.timestamps.size();
+    matrix.pnl.assign(responses.size() * columns, std::numeric_limits<double>::quiet_NaN());
+    for (size_t row = 0; row < responses.size(); ++row) {
+        double* values = matrix.pnl.data() + row * columns;
+        for (const auto& point : responses[row].pnl_over_time) {
+            auto it = std::lower_bound(matrix.timestamps.begin(), matrix.timestamps.end(), point.timestamp);
+            values[it - matrix.timestamps.begin()] = point.pnl_to_date;
+        }
+        if (options.forward_fill) {
+            for (size_t column = 1; column < columns; ++column) {
+                if (std::isnan(values[column]) && !std::isnan(values[column - 1])) {
+                    values[column] = values[column - 1];
+                }
+            }
+        }
+    }
+
+    return matrix;
+}
+
 }  // namespace dome
@@ -0,0 +1,338 @@
+#include "dome_api_sdk/event_bus.hpp"
+#include "dome_api_sdk/spsc_ring.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace dome {
+
+using Clock = std::chrono::steady_clock;
+
+// Longest dispatcher sleep when nothing is held
+static constexpr std::chrono::milliseconds IDLE_WAIT{100};
+
+struct EventBus::Source::Inbox {
+    // The reorder window runs from publication, however late the dispatcher picks it up
+    struct Published {
+        std::shared_ptr<BusEvent> event;
+        Clock::time_point at;
+    };
+
+    explicit Inbox(size_t capacity) : ring(capacity) {}
+
+    SpscRing<Published> ring;
+    std::atomic<uint64_t> published{0};  // bumped after each push, to wake the dispatcher safely
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<bool> closed{false};  // source gone; removed once drained
+};
+
+struct EventBus::Subscription::Ring {
+    explicit Ring(size_t capacity) : ring(capacity) {}
+
+    SpscRing<std::shared_ptr<const BusEvent>> ring;
+    std::atomic<uint64_t> delivered{0};  // bumped after each push, to wake the consumer safely
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<bool> waiting{false};  // consumer is (about to be) blocked in wait_pop
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    // Dispatcher side: queue event and wake a waiting consumer. The seq_cst bump and
+    // the load of waiting pair with wait_pop's store of waiting and load of delivered,
+    // so either the consumer sees the event or this sees the consumer waiting.
+    void deliver(const std::shared_ptr<const BusEvent>& event) {
+        std::shared_ptr<const BusEvent> copy = event;
+        if (!ring.try_push(std::move(copy))) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        delivered.fetch_add(1);
+        if (waiting.load()) {
+            std::lock_guard<std::mutex> lock(mutex);
+            cv.notify_one();
+        }
+    }
+};
+
+struct EventBus::State {
+    using Inboxes = std::vector<std::shared_ptr<Source::Inbox>>;
+    using Rings = std::vector<std::shared_ptr<Subscription::Ring>>;
+
+    // An event waiting out the reorder window
+    struct Held {
+        int64_t timestamp;
+        uint64_t arrival;
+        Clock::time_point release_at;
+        std::shared_ptr<BusEvent> event;
+    };
+
+    // Min-heap order: oldest timestamp first, then arrival
+    struct Later {
+        bool operator()(const Held& a, const Held& b) const {
+            return a.timestamp != b.timestamp ? a.timestamp > b.timestamp : a.arrival > b.arrival;
+        }
+    };
+
+    EventBusOptions options;
+
+    // Registrations; the lists are published as snapshots read with std::atomic_load
+    std::mutex mutex;
+    std::shared_ptr<const Inboxes> inboxes = std::make_shared<Inboxes>();
+    std::shared_ptr<const Rings> rings = std::make_shared<Rings>();
+    uint32_t next_source = 1;
+
+    // Dispatcher, serialized by dispatch_mutex
+    std::mutex dispatch_mutex;
+    std::priority_queue<Held, std::vector<Held>, Later> held;
+    uint64_t next_arrival = 0;
+    int64_t released_high = std::numeric_limits<int64_t>::min();
+
+    // Dispatcher thread and its wakeups
+    std::atomic<bool> idle{false};
+    std::mutex wake_mutex;
+    std::condition_variable wake_cv;
+    bool stopping = false;  // guarded by wake_mutex
+    std::mutex thread_mutex;
+    std::thread thread;
+
+    // Producer side, after bumping its inbox's published count: wake the dispatcher if
+    // it is sleeping (or about to, in which case it sees the count change)
+    void wake() {
+        if (idle.load()) {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            wake_cv.notify_one();
+        }
+    }
+
+    template<typename List, typename Update>
+    void update(std::shared_ptr<const List>& list, Update update) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto next = std::make_shared<List>(*std::atomic_load(&list));
+        update(*next);
+        std::atomic_store(&list, std::shared_ptr<const List>(std::move(next)));
+    }
+
+    // Requires dispatch_mutex
+    size_t pump() {
+        auto now = Clock::now();
+        auto sources = std::atomic_load(&inboxes);
+        bool drained_closed = false;
+        Source::Inbox::Published published;
+        for (const auto& inbox : *sources) {
+            bool closed = inbox->closed.load(std::memory_order_acquire);
+            while (inbox->ring.try_pop(published)) {
+                int64_t timestamp = published.event->timestamp;
+                held.push({timestamp, next_arrival++, published.at + options.reorder_window,
+                           std::move(published.event)});
+            }
+            drained_closed = drained_closed || closed;
+        }
+        if (drained_closed) {
+            update(inboxes, [](Inboxes& list) {
+                list.erase(std::remove_if(list.begin(), list.end(),
+                                          [](const auto& inbox) { return inbox->closed.load() && inbox->ring.empty(); }),
+                           list.end());
+            });
+        }
+
+        size_t delivered = 0;
+        auto subscribers = std::atomic_load(&rings);
+        while (!held.empty() && (held.top().release_at <= now || held.size() > options.max_held)) {
+            std::shared_ptr<BusEvent> next = std::move(const_cast<Held&>(held.top()).event);
+            held.pop();
+            if (next->timestamp < released_high) {
+                next->late = true;
+            } else {
+                released_high = next->timestamp;
+            }
+            std::shared_ptr<const BusEvent> shared = std::move(next);
+            for (const auto& ring : *subscribers) {
+                ring->deliver(shared);
+            }
+            ++delivered;
+        }
+        return delivered;
+    }
+
+    uint64_t published() const {
+        auto sources = std::atomic_load(&inboxes);
+        uint64_t total = 0;
+        for (const auto& inbox : *sources) {
+            total += inbox->published.load();
+        }
+        return total;
+    }
+
+    void run() {
+        while (true) {
+            Clock::time_point until;
+            uint64_t seen = published();
+            {
+                std::lock_guard<std::mutex> dispatch(dispatch_mutex);
+                pump();
+                until = held.empty() ? Clock::now() + IDLE_WAIT : held.top().release_at;
+            }
+
+            std::unique_lock<std::mutex> lock(wake_mutex);
+            if (stopping) {
+                return;
+            }
+            idle.store(true);
+            wake_cv.wait_until(lock, until, [&] { return stopping || published() != seen; });
+            idle.store(false);
+        }
+    }
+};
+
+// Source
+
+EventBus::Source::Source(std::shared_ptr<State> state, uint32_t id, std::string name)
+    : state_(std::move(state)),
+      inbox_(std::make_shared<Inbox>(state_->options.source_capacity)),
+      id_(id),
+      name_(std::move(name)) {}
+
+EventBus::Source::~Source() {
+    inbox_->closed.store(true, std::memory_order_release);
+}
+
+bool EventBus::Source::publish(int64_t timestamp, BusPayload payload) {
+    auto event = std::make_shared<BusEvent>();
+    event->source = id_;
+    event->sequence = next_sequence_++;
+    event->timestamp = timestamp;
+    event->payload = std::move(payload);
+    if (!inbox_->ring.try_push({std::move(event), Clock::now()})) {
+        inbox_->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    inbox_->published.fetch_add(1);
+    state_->wake();
+    return true;
+}
+
+bool EventBus::Source::publish(WebSocketOrderEvent event) {
+    int64_t timestamp = event.data.timestamp;
+    return publish(timestamp, BusPayload(std::move(event)));
+}
+
+bool EventBus::Source::publish(Activity activity) {
+    int64_t timestamp = activity.timestamp;
+    return publish(timestamp, BusPayload(std::move(activity)));
+}
+
+bool EventBus::Source::publish(PriceMark mark) {
+    int64_t timestamp = mark.at_time;
+    return publish(timestamp, BusPayload(std::move(mark)));
+}
+
+OrderEventCallback EventBus::Source::order_callback() {
+    return [self = shared_from_this()](const WebSocketOrderEvent& event) { self->publish(event); };
+}
+
+std::function<void(const Activity&)> EventBus::Source::activity_callback() {
+    return [self = shared_from_this()](const Activity& activity) { self->publish(activity); };
+}
+
+uint64_t EventBus::Source::dropped() const {
+    return inbox_->dropped.load(std::memory_order_relaxed);
+}
+
+// Subscription
+
+EventBus::Subscription::Subscription(std::shared_ptr<State> state, std::shared_ptr<Ring> ring)
+    : state_(std::move(state)), ring_(std::move(ring)) {}
+
+EventBus::Subscription::~Subscription() {
+    state_->update(state_->rings, [this](State::Rings& list) {
+        list.erase(std::remove(list.begin(), list.end(), ring_), list.end());
+    });
+}
+
+bool EventBus::Subscription::try_pop(std::shared_ptr<const BusEvent>& event) {
+    return ring_->ring.try_pop(event);
+}
+
+bool EventBus::Subscription::wait_pop(std::shared_ptr<const BusEvent>& event, std::chrono::milliseconds timeout) {
+    if (ring_->ring.try_pop(event)) {
+        return true;
+    }
+    std::unique_lock<std::mutex> lock(ring_->mutex);
+    ring_->waiting.store(true);
+    bool popped = ring_->cv.wait_for(lock, timeout, [&] {
+        ring_->delivered.load();  // orders the check after the store of waiting
+        return ring_->ring.try_pop(event);
+    });
+    ring_->waiting.store(false);
+    return popped;
+}
+
+uint64_t EventBus::Subscription::dropped() const {
+    return ring_->dropped.load(std::memory_order_relaxed);
+}
+
+// EventBus
+
+EventBus::EventBus(EventBusOptions options) : options_(options), state_(std::make_shared<State>()) {
+    options_.reorder_window = std::max(options_.reorder_window, std::chrono::milliseconds(0));
+    options_.max_held = std::max<size_t>(1, options_.max_held);
+    state_->options = options_;
+}
+
+EventBus::~EventBus() {
+    stop();
+}
+
+std::shared_ptr<EventBus::Source> EventBus::add_source(const std::string& name) {
+    uint32_t id = 0;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        id = state_->next_source++;
+    }
+    std::shared_ptr<Source> source(new Source(state_, id, name));
+    state_->update(state_->inboxes, [&](State::Inboxes& list) { list.push_back(source->inbox_); });
+    return source;
+}
+
+std::unique_ptr<EventBus::Subscription> EventBus::subscribe() {
+    auto ring = std::make_shared<Subscription::Ring>(options_.subscriber_capacity);
+    state_->update(state_->rings, [&](State::Rings& list) { list.push_back(ring); });
+    return std::unique_ptr<Subscription>(new Subscription(state_, std::move(ring)));
+}
+
+void EventBus::start() {
+    std::lock_guard<std::mutex> lock(state_->thread_mutex);
+    if (state_->thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> wake_lock(state_->wake_mutex);
+        state_->stopping = false;
+    }
+    state_->thread = std::thread([state = state_] { state->run(); });
+}
+
+void EventBus::stop() {
+    std::lock_guard<std::mutex> lock(state_->thread_mutex);
+    {
+        std::lock_guard<std::mutex> wake_lock(state_->wake_mutex);
+        state_->stopping = true;
+    }
+    state_->wake_cv.notify_all();
+    if (state_->thread.joinable()) {
+        state_->thread.join();
+    }
+}
+
+size_t EventBus::pump() {
+    std::lock_guard<std::mutex> lock(state_->dispatch_mutex);
+    return state_->pump();
+}
+
+}  // namespace dome
@@ -1,5 +1,17 @@
 #include "dome_api_sdk/http_client.hpp"
+#include "dome_api_sdk/url_encode.hpp"
+#include "dome_api_sdk/request_scheduler.hpp"
 #include <curl/curl.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <istream>
+#include <streambuf>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <atomic>
+#include <unordered_map>
 
 
 namespace dome {
@@ -11,102 +23,706 @@ static size_t write_callback(void* contents, size_t size, size_t nmemb, std::str
     return total_size;
 }
 
-HttpClient::HttpClient(const std::string& base_url, const std::string& api_key, float timeout)
-    : base_url_(base_url), api_key_(api_key), timeout_(timeout) {
-    // Initialize libcurl globally (should be done once per application)
-    static bool curl_initialized = false;
-    if (!curl_initialized) {
-        curl_global_init(CURL_GLOBAL_DEFAULT);
-        curl_initialized = true;
+static struct curl_slist* build_header_list(const std::map<std::string, std::string>& headers) {
+    struct curl_slist* list = nullptr;
+    for (const auto& [key, value] : headers) {
+        std::string header = key + ": " + value;
+        list = curl_slist_append(list, header.c_str());
+    }
+    return list;
+}
+
+using HeaderList = std::unique_ptr<struct curl_slist, decltype(&curl_slist_free_all)>;
+using Clock = std::chrono::steady_clock;
+
+// curl_global_init is not thread-safe; run it exactly once, before any other curl call
+static void ensure_curl_initialized() {
+    static std::once_flag once;
+    std::call_once(once, [] { curl_global_init(CURL_GLOBAL_DEFAULT); });
+}
+
+struct RequestSettings {
+    std::map<std::string, std::string> headers;
+    std::optional<std::string> accept_encoding = std::string();
+    std::shared_ptr<TransferStats> stats;
+    std::shared_ptr<ConnectionPool> pool;
+    std::shared_ptr<RequestScheduler> scheduler;
+    std::shared_ptr<CircuitBreaker> circuit_breaker;
+    std::chrono::milliseconds connect_timeout{0};
+    std::chrono::milliseconds first_byte_timeout{0};
+    struct curl_slist* header_list = nullptr;  // built from headers before publishing
+
+    RequestSettings() = default;
+    RequestSettings(const RequestSettings& other)
+        : headers(other.headers), accept_encoding(other.accept_encoding), stats(other.stats), pool(other.pool),
+          scheduler(other.scheduler), circuit_breaker(other.circuit_breaker), connect_timeout(other.connect_timeout),
+          first_byte_timeout(other.first_byte_timeout) {}
+    RequestSettings& operator=(const RequestSettings&) = delete;
+
+    ~RequestSettings() {
+        curl_slist_free_all(header_list);
+    }
+};
+
+static long to_milliseconds(float seconds) {
+    return static_cast<long>(std::lround(seconds * 1000.0f));
+}
+
+// Limits of one call: its RequestConfig over the client's defaults
+struct CallLimits {
+    long timeout_ms = 0;
+    long connect_timeout_ms = 0;
+    std::chrono::milliseconds first_byte_timeout{0};
+    CancellationToken cancellation;
+
+    // Whether the transfer needs a TransferWatch while it runs
+    bool watched() const { return first_byte_timeout.count() > 0 || cancellation.can_be_cancelled(); }
+};
+
+// Resolve the limits of a call; the total timeout is cut short by the deadline.
+// Throws if the call is already cancelled or past its deadline.
+static CallLimits call_limits(const RequestConfig& request, float client_timeout, const RequestSettings& settings) {
+    if (request.cancellation.cancelled()) {
+        throw request_cancelled_error();
+    }
+    CallLimits limits;
+    limits.timeout_ms = request.timeout > 0 ? static_cast<long>(request.timeout * 1000) : to_milliseconds(client_timeout);
+    if (request.deadline) {
+        // Rounded up, so that a transfer timing out has really reached the deadline
+        auto remaining = std::chrono::ceil<std::chrono::milliseconds>(*request.deadline - Clock::now()).count();
+        if (remaining <= 0) {
+            throw deadline_exceeded_error();
+        }
+        limits.timeout_ms = limits.timeout_ms > 0 ? std::min<long>(limits.timeout_ms, static_cast<long>(remaining))
+                                                  : static_cast<long>(remaining);
+    }
+    auto connect_timeout = request.connect_timeout.count() > 0 ? request.connect_timeout : settings.connect_timeout;
+    limits.connect_timeout_ms = static_cast<long>(connect_timeout.count());
+    limits.first_byte_timeout =
+        request.first_byte_timeout.count() > 0 ? request.first_byte_timeout : settings.first_byte_timeout;
+    limits.cancellation = request.cancellation;
+    return limits;
+}
+
+// Options shared by every request: URL, timeouts, response sink, headers and encodings.
+// headers replaces the client's header list when given. With an accept_encoding,
+// libcurl sends Accept-Encoding and decompresses the body before it reaches the
+// write callback.
+static void configure_handle(CURL* curl, const std::string& url, const RequestSettings& settings,
+                             const CallLimits& limits, std::string* response_body,
+                             struct curl_slist* headers = nullptr) {
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, limits.timeout_ms);
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, limits.connect_timeout_ms);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, response_body);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers ? headers : settings.header_list);
+    curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING,
+                     settings.accept_encoding.has_value() ? settings.accept_encoding->c_str() : nullptr);
+    curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+}
+
+// Header list with the call's extra headers merged over the client's; empty when
+// the call has none, so the client's prebuilt list is used
+static HeaderList call_headers(const RequestSettings& settings, const RequestConfig& request) {
+    if (request.headers.empty()) {
+        return HeaderList(nullptr, &curl_slist_free_all);
+    }
+    std::map<std::string, std::string> headers = settings.headers;
+    for (const auto& [key, value] : request.headers) {
+        headers[key] = value;
+    }
+    return HeaderList(build_header_list(headers), &curl_slist_free_all);
+}
+
+// Report a transfer cut off by the call's deadline as a deadline error
+static void check_deadline(CURLcode res, const RequestConfig& request) {
+    if (res == CURLE_OPERATION_TIMEDOUT && request.deadline && Clock::now() >= *request.deadline) {
+        throw deadline_exceeded_error();
+    }
+}
+
+// Health signal of a finished transfer. Timeouts count as overload whether they come
+// from the client, the deadline or the first-byte limit; only cancellation is ignored.
+static RequestOutcome classify_outcome(CURLcode res, long http_code, const RequestConfig& request) {
+    if (res != CURLE_OK) {
+        return request.cancellation.cancelled() ? RequestOutcome::IGNORED : RequestOutcome::OVERLOADED;
+    }
+    if (http_code == 429 || http_code >= 500) {
+        return RequestOutcome::OVERLOADED;
+    }
+    return http_code >= 400 ? RequestOutcome::FAILED : RequestOutcome::SUCCESS;
+}
+
+// A call let through by the circuit breaker (if any), which must hear how it went.
+// Throws CircuitOpenError when the circuit is open; counts as IGNORED unless reported.
+class BreakerAdmission {
+public:
+    BreakerAdmission(std::shared_ptr<CircuitBreaker> breaker, std::string route)
+        : breaker_(std::move(breaker)), route_(std::move(route)) {
+        if (breaker_) {
+            ticket_ = breaker_->allow(route_);
+        }
+    }
+    ~BreakerAdmission() { report(RequestOutcome::IGNORED); }
+
+    BreakerAdmission(BreakerAdmission&&) noexcept = default;
+    BreakerAdmission& operator=(BreakerAdmission&&) = delete;
+
+    void report(RequestOutcome outcome) {
+        if (breaker_) {
+            std::shared_ptr<CircuitBreaker> breaker = std::move(breaker_);
+            breaker->record(route_, outcome, ticket_);
+        }
+    }
+
+private:
+    std::shared_ptr<CircuitBreaker> breaker_;
+    std::string route_;
+    CircuitBreaker::Ticket ticket_ = 0;
+};
+
+// Circuit key of endpoint, computed only when a breaker will use it
+static std::string breaker_route(const RequestSettings& settings, const std::string& endpoint) {
+    return settings.circuit_breaker ? CircuitBreaker::route_of(endpoint) : std::string();
+}
+
+// Watches a running transfer for cancellation and for its first-byte timeout.
+// The owner drives the transfer and calls check() after each pass.
+class TransferWatch {
+public:
+    TransferWatch() = default;
+    explicit TransferWatch(const CallLimits& limits) : cancellation_(limits.cancellation) {
+        if (limits.first_byte_timeout.count() > 0) {
+            first_byte_deadline_ = Clock::now() + limits.first_byte_timeout;
+        }
+    }
+
+    // Error to abort the transfer with, or null to let it continue
+    std::exception_ptr check(CURL* curl) {
+        if (cancellation_.cancelled()) {
+            return std::make_exception_ptr(request_cancelled_error());
+        }
+        if (first_byte_deadline_) {
+            long http_code = 0;
+            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+            if (http_code != 0) {
+                first_byte_deadline_.reset();
+            } else if (Clock::now() >= *first_byte_deadline_) {
+                return std::make_exception_ptr(DomeAPIError(-1, "No response within the first-byte timeout"));
+            }
+        }
+        return nullptr;
+    }
+
+    // Longest wait before check() needs to run again
+    int wait_ms(int max_ms) const {
+        if (!first_byte_deadline_) {
+            return max_ms;
+        }
+        auto until = std::chrono::ceil<std::chrono::milliseconds>(*first_byte_deadline_ - Clock::now()).count();
+        return static_cast<int>(std::clamp<long long>(until, 0, max_ms));
+    }
+
+private:
+    CancellationToken cancellation_;
+    std::optional<Clock::time_point> first_byte_deadline_;
+};
+
+// Perform a transfer on a lane's multi handle, so that cancelling wakes it up and
+// the watch is checked while it waits. Sets aborted when the watch stopped it.
+// The lane removes the handle from its multi handle when it goes back to the pool.
+static CURLcode perform_watched(CURLM* multi, CURL* curl, TransferWatch& watch, const CancellationToken& cancellation,
+                                std::exception_ptr& aborted) {
+    curl_multi_add_handle(multi, curl);
+    CancellationCallback wake(cancellation, [multi] { curl_multi_wakeup(multi); });
+
+    while (true) {
+        int running = 0;
+        curl_multi_perform(multi, &running);
+        int queued = 0;
+        while (CURLMsg* message = curl_multi_info_read(multi, &queued)) {
+            if (message->msg == CURLMSG_DONE) {
+                return message->data.result;
+            }
+        }
+        aborted = watch.check(curl);
+        if (aborted) {
+            return CURLE_ABORTED_BY_CALLBACK;
+        }
+        curl_multi_poll(multi, nullptr, 0, watch.wait_ms(1000), nullptr);
     }
+}
+
+// Add a finished transfer to stats: body bytes on the wire vs. after decompression
+static void record_transfer(TransferStats* stats, CURL* curl, size_t decoded_bytes) {
+    if (stats == nullptr) {
+        return;
+    }
+    curl_off_t wire_bytes = 0;
+    long header_bytes = 0;
+    curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &wire_bytes);
+    curl_easy_getinfo(curl, CURLINFO_HEADER_SIZE, &header_bytes);
+    stats->record(static_cast<uint64_t>(wire_bytes), decoded_bytes, static_cast<uint64_t>(header_bytes));
+}
+
+// Throw DomeAPIError for transport failures and HTTP error statuses
+static void check_response(CURLcode res, long http_code, const std::string& response_body) {
+    // Check for CURL errors
+    if (res != CURLE_OK) {
+        throw DomeAPIError(-1, std::string("CURL error: ") + curl_easy_strerror(res));
+    }
+
+    // Check for HTTP errors
+    if (http_code >= 400) {
+        std::string error_message = "HTTP Error " + std::to_string(http_code);
+        
+        // Try to parse JSON error response
+        try {
+            auto json_error = nlohmann::json::parse(response_body);
+            if (json_error.contains("error")) {
+                std::string api_error = json_error.value("error", "");
+                std::string api_message = json_error.value("message", "Unknown error");
+                error_message = "API Error: " + api_error + " - " + api_message;
+            }
+        } catch (...) {
+            // If parsing fails, use default message
+        }
+        
+        throw DomeAPIError(static_cast<int>(http_code), error_message, response_body);
+    }
+}
+
+static nlohmann::json parse_response(const std::string& response) {
+    try {
+        return nlohmann::json::parse(response);
+    } catch (const nlohmann::json::parse_error& e) {
+        throw DomeAPIError(-1, std::string("JSON parse error: ") + e.what(), response);
+    }
+}
+
+// ConnectionPool
+
+struct ConnectionPool::State {
+    // A multi handle and an easy handle used by one call at a time. The multi handle
+    // keeps the connections between calls, so a connection is only ever used by the
+    // thread holding its lane (libcurl cannot share one connection cache between threads).
+    struct Lane {
+        CURLM* multi = nullptr;
+        CURL* curl = nullptr;
+        std::chrono::steady_clock::time_point idle_since;
+        bool warming = false;  // idle, but running a warmup request; not handed out until done
+
+        ~Lane() {
+            if (curl) curl_easy_cleanup(curl);
+            if (multi) curl_multi_cleanup(multi);
+        }
+    };
+
+    // A lane checked out of the pool; returned to it on destruction
+    class Lease {
+    public:
+        Lease(State* state, std::unique_ptr<Lane> lane) : state_(state), lane_(std::move(lane)) {}
+        ~Lease() {
+            if (lane_) state_->release(std::move(lane_));
+        }
+
+        Lease(Lease&&) noexcept = default;
+        Lease& operator=(Lease&&) = delete;
+
+        CURLM* multi() const { return lane_->multi; }
+        CURL* curl() const { return lane_->curl; }
+
+    private:
+        State* state_;
+        std::unique_ptr<Lane> lane_;
+    };
+
+    CURLSH* share = nullptr;
+    size_t max_lanes = 0;
+    std::mutex locks[CURL_LOCK_DATA_LAST];
+
+    std::mutex lanes_mutex;
+    std::condition_variable lane_warmed;
+    std::vector<std::unique_ptr<Lane>> idle;  // most recently used last
+
+    std::mutex thread_mutex;
+    std::condition_variable stop_cv;
+    std::thread keepalive_thread;
+    bool stopping = false;
+
+    ~State() {
+        idle.clear();
+        if (share) curl_share_cleanup(share);
+    }
+
+    // Make a handle take DNS entries and TLS sessions from the pool
+    void attach(CURL* curl) const {
+        curl_easy_setopt(curl, CURLOPT_SHARE, share);
+    }
+
+    static std::unique_ptr<Lane> make_lane() {
+        auto lane = std::make_unique<Lane>();
+        lane->multi = curl_multi_init();
+        lane->curl = curl_easy_init();
+        if (!lane->multi || !lane->curl) {
+            throw DomeAPIError(-1, "Failed to initialize CURL");
+        }
+        return lane;
+    }
+
+    // Check out the most recently used idle lane, or a new one. Lanes being warmed stay
+    // in the pool: when they are all that is idle, wait for one rather than open a cold lane.
+    Lease acquire() {
+        std::unique_ptr<Lane> lane;
+        {
+            std::unique_lock<std::mutex> lock(lanes_mutex);
+            while (!lane) {
+                auto ready = std::find_if(idle.rbegin(), idle.rend(), [](const auto& idle_lane) {
+                    return !idle_lane->warming;
+                });
+                if (ready != idle.rend()) {
+                    lane = std::move(*ready);
+                    idle.erase(std::next(ready).base());
+                } else if (idle.empty()) {
+                    break;
+                } else {
+                    lane_warmed.wait(lock);
+                }
+            }
+        }
+        if (!lane) {
+            lane = make_lane();
+        }
+        return Lease(this, std::move(lane));
+    }
+
+    // Keep a lane's connections for the next call, up to max_lanes idle lanes
+    void release(std::unique_ptr<Lane> lane) {
+        curl_multi_remove_handle(lane->multi, lane->curl);
+        curl_easy_reset(lane->curl);
+        {
+            std::lock_guard<std::mutex> lock(lanes_mutex);
+            if (idle.size() < max_lanes) {
+                lane->idle_since = std::chrono::steady_clock::now();
+                idle.push_back(std::move(lane));
+            }
+        }
+        // A surplus lane closes its connections here, outside the lock
+    }
+
+    // Mark up to count idle lanes as warming, most recently used first, skipping lanes
+    // used within min_idle; with grow, add new lanes to the pool to make up count
+    std::vector<Lane*> start_warming(size_t count, std::chrono::steady_clock::duration min_idle, bool grow) {
+        std::vector<Lane*> lanes;
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(lanes_mutex);
+        for (auto it = idle.rbegin(); it != idle.rend() && lanes.size() < count; ++it) {
+            Lane& lane = **it;
+            if (!lane.warming && now - lane.idle_since >= min_idle) {
+                lane.warming = true;
+                lanes.push_back(&lane);
+            }
+        }
+        try {
+            while (grow && lanes.size() < count && idle.size() < max_lanes) {
+                idle.insert(idle.begin(), make_lane());
+                idle.front()->warming = true;
+                lanes.push_back(idle.front().get());
+            }
+        } catch (const DomeAPIError&) {
+            for (Lane* lane : lanes) {
+                lane->warming = false;
+            }
+            lane_warmed.notify_all();
+            throw;
+        }
+        return lanes;
+    }
+
+    // Send a HEAD request to url on each warming lane, all in parallel, then hand the
+    // lanes out again. Each request takes its lane's idle connection if it is still
+    // alive, otherwise a new one, and leaves it in the lane. Returns how many succeeded.
+    size_t warm(const std::vector<Lane*>& lanes, const std::string& url, struct curl_slist* headers,
+                long timeout_seconds) {
+        for (Lane* lane : lanes) {
+            curl_easy_setopt(lane->curl, CURLOPT_URL, url.c_str());
+            curl_easy_setopt(lane->curl, CURLOPT_NOBODY, 1L);
+            curl_easy_setopt(lane->curl, CURLOPT_TIMEOUT, timeout_seconds);
+            curl_easy_setopt(lane->curl, CURLOPT_HTTPHEADER, headers);
+            curl_easy_setopt(lane->curl, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));
+            curl_easy_setopt(lane->curl, CURLOPT_TCP_KEEPALIVE, 1L);
+            attach(lane->curl);
+            curl_multi_add_handle(lane->multi, lane->curl);
+        }
+
+        size_t warmed = 0;
+        std::vector<bool> running(lanes.size(), true);
+        size_t remaining = lanes.size();
+        while (remaining > 0) {
+            CURLM* waiting = nullptr;
+            for (size_t i = 0; i < lanes.size(); ++i) {
+                if (!running[i]) {
+                    continue;
+                }
+                int still_running = 0;
+                curl_multi_perform(lanes[i]->multi, &still_running);
+                int queued = 0;
+                while (CURLMsg* message = curl_multi_info_read(lanes[i]->multi, &queued)) {
+                    if (message->msg == CURLMSG_DONE) {
+                        running[i] = false;
+                        --remaining;
+                        warmed += message->data.result == CURLE_OK;
+                    }
+                }
+                if (running[i] && !waiting) {
+                    waiting = lanes[i]->multi;
+                }
+            }
+            // Lanes have separate multi handles; wait on one and poll the rest shortly after
+            if (waiting) {
+                curl_multi_poll(waiting, nullptr, 0, 10, nullptr);
+            }
+        }
+
+        for (Lane* lane : lanes) {
+            curl_multi_remove_handle(lane->multi, lane->curl);
+            curl_easy_reset(lane->curl);
+        }
+        {
+            std::lock_guard<std::mutex> lock(lanes_mutex);
+            auto now = std::chrono::steady_clock::now();
+            for (Lane* lane : lanes) {
+                lane->warming = false;
+                lane->idle_since = now;
+            }
+        }
+        lane_warmed.notify_all();
+        return warmed;
+    }
+
+    static void lock(CURL*, curl_lock_data data, curl_lock_access, void* userptr) {
+        static_cast<State*>(userptr)->locks[data].lock();
+    }
+
+    static void unlock(CURL*, curl_lock_data data, void* userptr) {
+        static_cast<State*>(userptr)->locks[data].unlock();
+    }
+};
+
+ConnectionPool::ConnectionPool(size_t max_connections)
+    : max_connections_(std::max<size_t>(1, max_connections)), state_(std::make_unique<State>()) {
+    ensure_curl_initialized();
+    state_->max_lanes = max_connections_;
+    state_->share = curl_share_init();
+    if (!state_->share) {
+        throw DomeAPIError(-1, "Failed to initialize CURL share handle");
+    }
+    curl_share_setopt(state_->share, CURLSHOPT_LOCKFUNC, &State::lock);
+    curl_share_setopt(state_->share, CURLSHOPT_UNLOCKFUNC, &State::unlock);
+    curl_share_setopt(state_->share, CURLSHOPT_USERDATA, state_.get());
+    curl_share_setopt(state_->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(state_->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+}
+
+ConnectionPool::~ConnectionPool() {
+    stop_keepalive();
+}
+
+size_t ConnectionPool::warmup(const std::string& url, size_t connections, long timeout_seconds,
+                              const std::map<std::string, std::string>& headers) {
+    std::vector<State::Lane*> lanes =
+        state_->start_warming(std::min(connections, max_connections_), std::chrono::steady_clock::duration::zero(), true);
+    if (lanes.empty()) {
+        return 0;
+    }
+    HeaderList header_list(build_header_list(headers), &curl_slist_free_all);
+    return state_->warm(lanes, url, header_list.get(), timeout_seconds);
+}
+
+void ConnectionPool::start_keepalive(const std::string& url, std::chrono::seconds interval,
+                                     const std::map<std::string, std::string>& headers, long timeout_seconds) {
+    std::lock_guard<std::mutex> lock(state_->thread_mutex);
+    if (state_->keepalive_thread.joinable()) {
+        return;
+    }
+    state_->stopping = false;
+    auto header_list = std::make_shared<HeaderList>(build_header_list(headers), &curl_slist_free_all);
+    state_->keepalive_thread = std::thread([this, url, interval, header_list, timeout_seconds] {
+        std::unique_lock<std::mutex> lock(state_->thread_mutex);
+        while (!state_->stop_cv.wait_for(lock, interval, [this] { return state_->stopping; })) {
+            lock.unlock();
+            try {
+                // Lanes used within the interval are kept alive by that use
+                std::vector<State::Lane*> lanes = state_->start_warming(max_connections_, interval, false);
+                if (!lanes.empty()) {
+                    state_->warm(lanes, url, header_list->get(), timeout_seconds);
+                }
+            } catch (const DomeAPIError&) {
+                // Try again next interval
+            }
+            lock.lock();
+        }
+    });
+}
+
+void ConnectionPool::stop_keepalive() {
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(state_->thread_mutex);
+        state_->stopping = true;
+        thread = std::move(state_->keepalive_thread);
+    }
+    state_->stop_cv.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+HttpClient::HttpClient(const std::string& base_url, const std::string& api_key, float timeout,
+                       std::shared_ptr<ConnectionPool> pool)
+    : base_url_(base_url), api_key_(api_key), timeout_(timeout) {
+    ensure_curl_initialized();
+
+    auto settings = std::make_shared<RequestSettings>();
 
     // Set default headers
-    headers_["Content-Type"] = "application/json";
-    headers_["Accept"] = "application/json";
-    headers_["x-dome-sdk"] = "cpp/1.0.0";
+    settings->headers["Content-Type"] = "application/json";
+    settings->headers["Accept"] = "application/json";
+    settings->headers["x-dome-sdk"] = "cpp/1.0.0";
     if (!api_key_.empty()) {
-        headers_["Authorization"] = "Bearer " + api_key_;
+        settings->headers["Authorization"] = "Bearer " + api_key_;
     }
+    settings->header_list = build_header_list(settings->headers);
+    settings->pool = pool ? std::move(pool) : std::make_shared<ConnectionPool>();
+    settings_ = std::move(settings);
 }
 
 HttpClient::~HttpClient() {
     // Note: curl_global_cleanup() should be called at application exit
 }
 
+std::shared_ptr<const RequestSettings> HttpClient::settings() const {
+    return std::atomic_load(&settings_);
+}
+
+void HttpClient::update_settings(const std::function<void(RequestSettings&)>& update) {
+    std::lock_guard<std::mutex> lock(settings_mutex_);
+    auto next = std::make_shared<RequestSettings>(*settings());
+    update(*next);
+    next->header_list = build_header_list(next->headers);
+    std::atomic_store(&settings_, std::shared_ptr<const RequestSettings>(std::move(next)));
+}
+
+size_t HttpClient::warmup(size_t connections) {
+    auto current = settings();
+    return current->pool->warmup(base_url_, connections, std::lround(timeout_), current->headers);
+}
+
+void HttpClient::start_keepalive(std::chrono::seconds interval) {
+    auto current = settings();
+    current->pool->start_keepalive(base_url_, interval, current->headers, std::lround(timeout_));
+}
+
 void HttpClient::set_header(const std::string& key, const std::string& value) {
-    headers_[key] = value;
+    update_settings([&](RequestSettings& settings) { settings.headers[key] = value; });
 }
 
-std::string HttpClient::url_encode(const std::string& value) {
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        return value;
+void HttpClient::set_accept_encoding(std::optional<std::string> encodings) {
+    update_settings([&](RequestSettings& settings) { settings.accept_encoding = std::move(encodings); });
+}
+
+void HttpClient::set_transfer_stats(std::shared_ptr<TransferStats> stats) {
+    update_settings([&](RequestSettings& settings) { settings.stats = std::move(stats); });
+}
+
+std::shared_ptr<TransferStats> HttpClient::transfer_stats() const {
+    return settings()->stats;
+}
+
+void HttpClient::set_connection_pool(std::shared_ptr<ConnectionPool> pool) {
+    if (!pool) {
+        pool = std::make_shared<ConnectionPool>();
     }
+    update_settings([&](RequestSettings& settings) { settings.pool = std::move(pool); });
+}
 
-    char* encoded = curl_easy_escape(curl, value.c_str(), static_cast<int>(value.length()));
-    std::string result(encoded);
-    curl_free(encoded);
-    curl_easy_cleanup(curl);
-    return result;
+std::shared_ptr<ConnectionPool> HttpClient::connection_pool() const {
+    return settings()->pool;
+}
+
+void HttpClient::set_connect_timeout(std::chrono::milliseconds timeout) {
+    update_settings([&](RequestSettings& settings) { settings.connect_timeout = timeout; });
+}
+
+void HttpClient::set_first_byte_timeout(std::chrono::milliseconds timeout) {
+    update_settings([&](RequestSettings& settings) { settings.first_byte_timeout = timeout; });
+}
+
+void HttpClient::set_scheduler(std::shared_ptr<RequestScheduler> scheduler) {
+    update_settings([&](RequestSettings& settings) { settings.scheduler = std::move(scheduler); });
+}
+
+std::shared_ptr<RequestScheduler> HttpClient::scheduler() const {
+    return settings()->scheduler;
+}
+
+void HttpClient::set_circuit_breaker(std::shared_ptr<CircuitBreaker> breaker) {
+    update_settings([&](RequestSettings& settings) { settings.circuit_breaker = std::move(breaker); });
+}
+
+std::shared_ptr<CircuitBreaker> HttpClient::circuit_breaker() const {
+    return settings()->circuit_breaker;
+}
+
+std::string HttpClient::url_encode(const std::string& value) {
+    return dome::url_encode(value);
 }
 
 std::string HttpClient::build_url(const std::string& endpoint,
                                    const std::map<std::string, std::string>& query_params) {
-    std::string url = base_url_;
-    
     // Ensure base_url doesn't end with '/' and endpoint starts with '/'
-    if (!base_url_.empty() && base_url_.back() == '/') {
-        url = base_url_.substr(0, base_url_.length() - 1);
-    }
-    if (!endpoint.empty() && endpoint.front() != '/') {
-        url += "/";
+    std::string_view base = base_url_;
+    if (!base.empty() && base.back() == '/') {
+        base.remove_suffix(1);
     }
-    url += endpoint;
 
-    // Add query parameters
-    if (!query_params.empty()) {
-        url += "?";
-        bool first = true;
-        for (const auto& [key, value] : query_params) {
-            if (!first) {
-                url += "&";
-            }
-            url += url_encode(key) + "=" + url_encode(value);
-            first = false;
-        }
+    QueryBuilder url(base, base.size() + endpoint.size() + 1 + query_params.size() * 48);
+    if (!endpoint.empty() && endpoint.front() != '/') {
+        url.append_path("/");
     }
+    url.append_path(endpoint);
 
-    return url;
+    // Add query parameters, encoded straight into the URL buffer
+    url.add_all(query_params);
+    return url.release();
 }
 
-std::string HttpClient::perform_request(const std::string& url,
+std::string HttpClient::perform_request(const std::string& endpoint,
+                                         const std::string& url,
                                          HTTPMethod method,
-                                         const std::string& body) {
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        throw DomeAPIError(-1, "Failed to initialize CURL");
+                                         const std::string& body,
+                                         const RequestConfig& request) {
+    // Held until the transfer is done: it owns the header list
+    std::shared_ptr<const RequestSettings> settings = this->settings();
+    BreakerAdmission breaker(settings->circuit_breaker, breaker_route(*settings, endpoint));
+    RequestScheduler::Permit permit;
+    if (settings->scheduler) {
+        permit = settings->scheduler->acquire(request);
     }
+    CallLimits limits = call_limits(request, timeout_, *settings);
+    HeaderList extra_headers = call_headers(*settings, request);
+
+    // A pooled handle whose lane keeps the connection for the next request
+    ConnectionPool::State::Lease lane = settings->pool->state_->acquire();
+    CURL* curl = lane.curl();
 
     std::string response_body;
     long http_code = 0;
 
-    // Set URL
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-
-    // Set timeout
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, static_cast<long>(timeout_));
-
-    // Set write callback
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_body);
-
-    // Set headers
-    struct curl_slist* headers = nullptr;
-    for (const auto& [key, value] : headers_) {
-        std::string header = key + ": " + value;
-        headers = curl_slist_append(headers, header.c_str());
-    }
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    configure_handle(curl, url, *settings, limits, &response_body, extra_headers.get());
+    settings->pool->state_->attach(curl);
 
     // Set method and body
     switch (method) {
@@ -131,64 +747,1085 @@ std::string HttpClient::perform_request(const std::string& url,
     }
 
     // Perform request
-    CURLcode res = curl_easy_perform(curl);
+    std::exception_ptr aborted;
+    TransferWatch watch(limits);
+    CURLcode res = perform_watched(lane.multi(), curl, watch, limits.cancellation, aborted);
 
     // Get HTTP response code
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+    record_transfer(settings->stats.get(), curl, response_body.size());
 
-    // Cleanup
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
-
-    // Check for CURL errors
-    if (res != CURLE_OK) {
-        throw DomeAPIError(-1, std::string("CURL error: ") + curl_easy_strerror(res));
-    }
-
-    // Check for HTTP errors
-    if (http_code >= 400) {
-        std::string error_message = "HTTP Error " + std::to_string(http_code);
-        
-        // Try to parse JSON error response
-        try {
-            auto json_error = nlohmann::json::parse(response_body);
-            if (json_error.contains("error")) {
-                std::string api_error = json_error.value("error", "");
-                std::string api_message = json_error.value("message", "Unknown error");
-                error_message = "API Error: " + api_error + " - " + api_message;
-            }
-        } catch (...) {
-            // If parsing fails, use default message
-        }
-        
-        throw DomeAPIError(static_cast<int>(http_code), error_message, response_body);
+    RequestOutcome outcome = classify_outcome(res, http_code, request);
+    permit.report(outcome);
+    breaker.report(outcome);
+    if (aborted) {
+        std::rethrow_exception(aborted);
     }
+    check_deadline(res, request);
+    check_response(res, http_code, response_body);
 
     return response_body;
 }
 
 nlohmann::json HttpClient::get(const std::string& endpoint,
-                                const std::map<std::string, std::string>& query_params) {
+                                const std::map<std::string, std::string>& query_params,
+                                const RequestConfig& request) {
     std::string url = build_url(endpoint, query_params);
-    std::string response = perform_request(url, HTTPMethod::GET);
-    
-    try {
-        return nlohmann::json::parse(response);
-    } catch (const nlohmann::json::parse_error& e) {
-        throw DomeAPIError(-1, std::string("JSON parse error: ") + e.what(), response);
-    }
+    std::string response = perform_request(endpoint, url, HTTPMethod::GET, "", request);
+    return parse_response(response);
 }
 
 nlohmann::json HttpClient::post(const std::string& endpoint, const nlohmann::json& body) {
     std::string url = build_url(endpoint, {});
     std::string body_str = body.empty() ? "" : body.dump();
-    std::string response = perform_request(url, HTTPMethod::POST, body_str);
-    
+    std::string response = perform_request(endpoint, url, HTTPMethod::POST, body_str);
+    return parse_response(response);
+}
+
+// Streaming decode
+
+// Input buffer that drives one transfer on a multi handle and exposes the body
+// bytes as they arrive, so a parser reading from it runs during the download.
+// Only the bytes received since the last refill are held. A transfer stopped by
+// the watch ends like a failed one, with aborted() holding the reason.
+class TransferStreamBuf : public std::streambuf {
+public:
+    TransferStreamBuf(CURL* curl, CURLM* multi, TransferWatch* watch) : curl_(curl), multi_(multi), watch_(watch) {
+        curl_easy_setopt(curl_, CURLOPT_WRITEFUNCTION, &TransferStreamBuf::on_data);
+        curl_easy_setopt(curl_, CURLOPT_WRITEDATA, this);
+    }
+
+    // Pump until the response status is known or the transfer ends
+    long wait_for_status() {
+        long http_code = 0;
+        while (!done_) {
+            curl_easy_getinfo(curl_, CURLINFO_RESPONSE_CODE, &http_code);
+            if (http_code != 0) {
+                break;
+            }
+            pump();
+        }
+        curl_easy_getinfo(curl_, CURLINFO_RESPONSE_CODE, &http_code);
+        return http_code;
+    }
+
+    // Pump the transfer to completion, appending everything not yet read to out
+    void drain(std::string& out) {
+        out.append(gptr(), egptr());
+        setg(nullptr, nullptr, nullptr);
+        while (!done_) {
+            pump();
+        }
+        out += pending_;
+        pending_.clear();
+    }
+
+    CURLcode result() const { return result_; }
+    bool done() const { return done_; }
+    size_t received() const { return received_; }
+    std::exception_ptr aborted() const { return aborted_; }
+
+protected:
+    int_type underflow() override {
+        current_.clear();
+        while (pending_.empty() && !done_) {
+            pump();
+        }
+        if (pending_.empty()) {
+            return traits_type::eof();
+        }
+        current_.swap(pending_);
+        setg(&current_[0], &current_[0], &current_[0] + current_.size());
+        return traits_type::to_int_type(current_[0]);
+    }
+
+private:
+    static size_t on_data(void* contents, size_t size, size_t nmemb, void* userp) {
+        auto* self = static_cast<TransferStreamBuf*>(userp);
+        self->pending_.append(static_cast<char*>(contents), size * nmemb);
+        self->received_ += size * nmemb;
+        return size * nmemb;
+    }
+
+    void pump() {
+        int running = 0;
+        curl_multi_perform(multi_, &running);
+        int queued = 0;
+        while (CURLMsg* message = curl_multi_info_read(multi_, &queued)) {
+            if (message->msg == CURLMSG_DONE) {
+                result_ = message->data.result;
+                done_ = true;
+            }
+        }
+        if (!done_ && watch_) {
+            aborted_ = watch_->check(curl_);
+            if (aborted_) {
+                result_ = CURLE_ABORTED_BY_CALLBACK;
+                done_ = true;
+            }
+        }
+        if (!done_ && pending_.empty()) {
+            curl_multi_poll(multi_, nullptr, 0, watch_ ? watch_->wait_ms(100) : 100, nullptr);
+        }
+    }
+
+    CURL* curl_;
+    CURLM* multi_;
+    TransferWatch* watch_;  // null when the call has nothing to watch
+    std::exception_ptr aborted_;
+    std::string pending_;  // received, not yet handed to the reader
+    std::string current_;  // get area
+    size_t received_ = 0;  // decoded body bytes so far
+    CURLcode result_ = CURLE_OK;
+    bool done_ = false;
+};
+
+// SAX handler that builds the document like nlohmann's DOM parser, except that
+// each completed element of the top-level records array is handed to a callback
+// and dropped instead of being kept.
+class RecordStreamSax : public nlohmann::json_sax<nlohmann::json> {
+public:
+    using json = nlohmann::json;
+
+    RecordStreamSax(const std::string& records_key, const std::function<void(const json&)>& on_record)
+        : records_key_(records_key), on_record_(on_record) {}
+
+    json& document() { return root_; }
+
+    bool null() override { value(nullptr); return true; }
+    bool boolean(bool v) override { value(v); return true; }
+    bool number_integer(json::number_integer_t v) override { value(v); return true; }
+    bool number_unsigned(json::number_unsigned_t v) override { value(v); return true; }
+    bool number_float(json::number_float_t v, const json::string_t&) override { value(v); return true; }
+    bool string(json::string_t& v) override { value(std::move(v)); return true; }
+    bool binary(json::binary_t& v) override { value(std::move(v)); return true; }
+
+    bool start_object(std::size_t) override {
+        stack_.push_back(value(json::value_t::object));
+        return true;
+    }
+
+    bool key(json::string_t& k) override {
+        key_ = std::move(k);
+        return true;
+    }
+
+    bool end_object() override {
+        stack_.pop_back();
+        complete();
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        json* array = value(json::value_t::array);
+        if (stack_.size() == 1 && key_ == records_key_) {
+            records_ = array;
+        }
+        stack_.push_back(array);
+        return true;
+    }
+
+    bool end_array() override {
+        stack_.pop_back();
+        complete();
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) override {
+        throw DomeAPIError(-1, std::string("JSON parse error: ") + e.what());
+    }
+
+private:
+    // Insert a value at the current position and return it
+    template<typename Value>
+    json* value(Value&& v) {
+        if (stack_.empty()) {
+            root_ = json(std::forward<Value>(v));
+            return &root_;
+        }
+        json& parent = *stack_.back();
+        if (parent.is_array()) {
+            parent.emplace_back(std::forward<Value>(v));
+            json* element = &parent.back();
+            if (&parent == records_ && !element->is_structured()) {
+                emit();
+            }
+            return element;
+        }
+        json& slot = parent[key_];
+        slot = json(std::forward<Value>(v));
+        return &slot;
+    }
+
+    // A structured value just closed; emit it if it was a record
+    void complete() {
+        if (!stack_.empty() && stack_.back() == records_ && records_ != nullptr) {
+            emit();
+        }
+    }
+
+    void emit() {
+        on_record_(records_->back());
+        records_->erase(records_->size() - 1);
+    }
+
+    const std::string& records_key_;
+    const std::function<void(const json&)>& on_record_;
+    json root_;
+    std::vector<json*> stack_;
+    json* records_ = nullptr;
+    json::string_t key_;
+};
+
+nlohmann::json HttpClient::get_streaming(const std::string& endpoint,
+                                         const std::map<std::string, std::string>& query_params,
+                                         const std::string& records_key,
+                                         const std::function<void(const nlohmann::json&)>& on_record,
+                                         const RequestConfig& request) {
+    RecordStreamSax sax(records_key, on_record);
+    get_sax(endpoint, query_params, sax, request);
+    return std::move(sax.document());
+}
+
+void HttpClient::get_sax(const std::string& endpoint, const std::map<std::string, std::string>& query_params,
+                         nlohmann::json_sax<nlohmann::json>& sax, const RequestConfig& request) {
+    // Outlives the handles below: it owns the header list
+    std::shared_ptr<const RequestSettings> settings = this->settings();
+    TransferStats* stats = settings->stats.get();
+    BreakerAdmission breaker(settings->circuit_breaker, breaker_route(*settings, endpoint));
+    RequestScheduler::Permit permit;
+    if (settings->scheduler) {
+        permit = settings->scheduler->acquire(request);
+    }
+    CallLimits limits = call_limits(request, timeout_, *settings);
+    HeaderList extra_headers = call_headers(*settings, request);
+    TransferWatch watch(limits);
+
+    // Outlives the stream below; an unfinished transfer is dropped when it goes back
+    ConnectionPool::State::Lease transfer = settings->pool->state_->acquire();
+    configure_handle(transfer.curl(), build_url(endpoint, query_params), *settings, limits, nullptr,
+                     extra_headers.get());
+    settings->pool->state_->attach(transfer.curl());
+    TransferStreamBuf buffer(transfer.curl(), transfer.multi(), limits.watched() ? &watch : nullptr);
+    curl_multi_add_handle(transfer.multi(), transfer.curl());
+    CancellationCallback wake(limits.cancellation, [multi = transfer.multi()] { curl_multi_wakeup(multi); });
+
+    // Finish the transfer and throw if it failed
+    long http_code = 0;
+    auto finish = [&](std::string& body) {
+        buffer.drain(body);
+        record_transfer(stats, transfer.curl(), buffer.received());
+        RequestOutcome outcome = classify_outcome(buffer.result(), http_code, request);
+        permit.report(outcome);
+        breaker.report(outcome);
+        if (buffer.aborted()) {
+            std::rethrow_exception(buffer.aborted());
+        }
+        check_deadline(buffer.result(), request);
+        check_response(buffer.result(), http_code, body);
+    };
+
+    // Error bodies are small; read them whole and report them the usual way
+    http_code = buffer.wait_for_status();
+    if (http_code >= 400 || (buffer.done() && buffer.result() != CURLE_OK)) {
+        std::string body;
+        finish(body);
+    }
+
+    std::istream input(&buffer);
     try {
-        return nlohmann::json::parse(response);
-    } catch (const nlohmann::json::parse_error& e) {
-        throw DomeAPIError(-1, std::string("JSON parse error: ") + e.what(), response);
+        nlohmann::json::sax_parse(input, &sax);
+    } catch (const DomeAPIError&) {
+        // A transfer that failed mid-body shows up as truncated JSON; report the transfer error
+        std::string rest;
+        finish(rest);
+        throw;
+    }
+
+    std::string rest;
+    finish(rest);
+}
+
+// PreparedRequest
+
+struct PreparedRequest::State {
+    CURL* curl = nullptr;
+    CURLM* multi = nullptr;  // keeps the connection between calls; lets cancellation wake a call
+    float timeout = 0;
+    std::string prefix;
+    QueryBuilder url;  // prefix plus the current call's path and query, reusing one buffer
+    std::string body;
+    std::shared_ptr<const RequestSettings> settings;  // outlives the handle using its header list and pool
+
+    ~State() {
+        if (curl) curl_easy_cleanup(curl);
+        if (multi) curl_multi_cleanup(multi);
+    }
+};
+
+PreparedRequest::PreparedRequest(std::string url_prefix, std::shared_ptr<const RequestSettings> settings,
+                                 float timeout)
+    : state_(std::make_unique<State>()) {
+    state_->curl = curl_easy_init();
+    state_->multi = curl_multi_init();
+    if (!state_->curl || !state_->multi) {
+        throw DomeAPIError(-1, "Failed to initialize CURL");
+    }
+    state_->timeout = timeout;
+    state_->settings = std::move(settings);
+    state_->prefix = std::move(url_prefix);
+    state_->url = QueryBuilder(state_->prefix, state_->prefix.size() + 256);
+    const RequestSettings& current = *state_->settings;
+    configure_handle(state_->curl, state_->prefix, current, call_limits(RequestConfig(), timeout, current),
+                     &state_->body);
+    current.pool->state_->attach(state_->curl);
+}
+
+PreparedRequest::PreparedRequest(PreparedRequest&&) noexcept = default;
+PreparedRequest& PreparedRequest::operator=(PreparedRequest&&) noexcept = default;
+PreparedRequest::~PreparedRequest() = default;
+
+const std::string& PreparedRequest::get_raw(std::string_view path_suffix,
+                                            std::initializer_list<QueryParam> query_params,
+                                            const RequestConfig& request) {
+    State& state = *state_;
+    const RequestSettings& settings = *state.settings;
+    const CallLimits limits = call_limits(request, state.timeout, settings);
+    HeaderList extra_headers = call_headers(settings, request);
+
+    state.url.reset(state.prefix).append_path(path_suffix);
+    for (const auto& [key, value] : query_params) {
+        state.url.add(key, value);
+    }
+
+    // Only what a call can change is set again; the rest was configured by the constructor
+    state.body.clear();
+    curl_easy_setopt(state.curl, CURLOPT_URL, state.url.str().c_str());
+    curl_easy_setopt(state.curl, CURLOPT_TIMEOUT_MS, limits.timeout_ms);
+    curl_easy_setopt(state.curl, CURLOPT_CONNECTTIMEOUT_MS, limits.connect_timeout_ms);
+    curl_easy_setopt(state.curl, CURLOPT_HTTPHEADER, extra_headers ? extra_headers.get() : settings.header_list);
+
+    std::exception_ptr aborted;
+    TransferWatch watch(limits);
+    CURLcode res = perform_watched(state.multi, state.curl, watch, limits.cancellation, aborted);
+    curl_multi_remove_handle(state.multi, state.curl);
+
+    long http_code = 0;
+    curl_easy_getinfo(state.curl, CURLINFO_RESPONSE_CODE, &http_code);
+    record_transfer(settings.stats.get(), state.curl, state.body.size());
+    if (aborted) {
+        std::rethrow_exception(aborted);
+    }
+    check_deadline(res, request);
+    check_response(res, http_code, state.body);
+    return state.body;
+}
+
+nlohmann::json PreparedRequest::get(std::string_view path_suffix,
+                                    std::initializer_list<QueryParam> query_params,
+                                    const RequestConfig& request) {
+    return parse_response(get_raw(path_suffix, query_params, request));
+}
+
+PreparedRequest HttpClient::prepare(const std::string& endpoint_prefix) const {
+    std::string url = base_url_;
+    if (!url.empty() && url.back() == '/') {
+        url.pop_back();
+    }
+    if (!endpoint_prefix.empty() && endpoint_prefix.front() != '/') {
+        url += '/';
     }
+    url += endpoint_prefix;
+    return PreparedRequest(std::move(url), settings(), timeout_);
+}
+
+std::vector<BatchResult> HttpClient::get_many(const std::vector<BatchRequest>& requests,
+                                              const BatchOptions& options, const RequestConfig& request) {
+    std::vector<BatchResult> results(requests.size());
+    if (requests.empty()) {
+        return results;
+    }
+
+    // Outlive the handles below: they own the header lists
+    std::shared_ptr<const RequestSettings> settings = this->settings();
+    HeaderList extra_headers = call_headers(*settings, request);
+
+    struct Transfer {
+        CURL* handle = nullptr;
+        size_t index = 0;
+        bool running = false;
+        std::string body;
+        TransferWatch watch;
+        std::optional<BreakerAdmission> breaker;
+        RequestScheduler::Permit permit;
+    };
+
+    // Permits the scheduler grants, handed over from whichever thread grants them
+    struct Admissions {
+        std::mutex mutex;
+        CURLM* multi = nullptr;  // null once the batch is over
+        std::vector<RequestScheduler::Permit> granted;
+        size_t pending = 0;  // queued in the scheduler, neither granted nor shed yet
+
+        void admit(RequestScheduler::Permit permit) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (multi) {
+                granted.push_back(std::move(permit));
+                --pending;
+                curl_multi_wakeup(multi);
+            }
+        }
+
+        void expire() {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (multi) {
+                --pending;
+                curl_multi_wakeup(multi);
+            }
+        }
+    };
+
+    // Owns the easy handles; the multi handle is a pooled lane's, so the connections
+    // the batch opens stay in the pool afterwards
+    struct Batch {
+        ConnectionPool::State::Lease lane;
+        CURLM* multi = nullptr;
+        std::vector<Transfer> transfers;
+
+        explicit Batch(ConnectionPool::State::Lease leased) : lane(std::move(leased)), multi(lane.multi()) {}
+        ~Batch() {
+            for (auto& transfer : transfers) {
+                if (transfer.handle) {
+                    curl_multi_remove_handle(multi, transfer.handle);
+                    curl_easy_cleanup(transfer.handle);
+                }
+            }
+            curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, 0L);
+        }
+    } batch(settings->pool->state_->acquire());
+    CancellationCallback wake(request.cancellation, [multi = batch.multi] { curl_multi_wakeup(multi); });
+
+    // With a scheduler every transfer runs on a BULK permit, so the batch counts against
+    // its limits and its outcomes feed the adaptive limit. Permits are queued for as many
+    // transfers as can start; whatever is left is withdrawn when the batch ends.
+    RequestConfig admission = request;
+    admission.priority = RequestPriority::BULK;
+    std::vector<RequestScheduler::Permit> permits;  // granted, not used yet
+    struct Queue {
+        std::shared_ptr<RequestScheduler> scheduler;
+        std::shared_ptr<Admissions> admissions = std::make_shared<Admissions>();
+        std::vector<uint64_t> tickets;
+
+        ~Queue() {
+            std::vector<RequestScheduler::Permit> unused;
+            {
+                std::lock_guard<std::mutex> lock(admissions->mutex);
+                admissions->multi = nullptr;
+                unused.swap(admissions->granted);
+            }
+            for (uint64_t ticket : tickets) {
+                scheduler->cancel(ticket);
+            }
+        }
+    } queue;
+    queue.scheduler = settings->scheduler;
+    queue.admissions->multi = batch.multi;
+
+    size_t concurrency = std::max<size_t>(1, std::min(options.max_concurrency, requests.size()));
+    curl_multi_setopt(batch.multi, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(concurrency));
+    curl_multi_setopt(batch.multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+
+    // Easy handles are reused across requests so connections stay warm
+    batch.transfers.resize(concurrency);
+    std::vector<Transfer*> idle;
+    for (auto& transfer : batch.transfers) {
+        transfer.handle = curl_easy_init();
+        if (!transfer.handle) {
+            throw DomeAPIError(-1, "Failed to initialize CURL");
+        }
+        idle.push_back(&transfer);
+    }
+
+    const auto started = Clock::now();
+    const double spacing = options.requests_per_second > 0 ? 1.0 / options.requests_per_second : 0.0;
+
+    size_t next = 0;
+    size_t running = 0;
+    while (next < requests.size() || running > 0) {
+        size_t pending_permits = 0;
+        if (queue.scheduler) {
+            std::lock_guard<std::mutex> lock(queue.admissions->mutex);
+            for (auto& permit : queue.admissions->granted) {
+                permits.push_back(std::move(permit));
+            }
+            queue.admissions->granted.clear();
+            pending_permits = queue.admissions->pending;
+        }
+
+        // Start as many requests as the concurrency, rate and scheduler limits allow
+        int wait_ms = 1000;
+        while (next < requests.size() && !idle.empty()) {
+            if (spacing > 0) {
+                auto due = started + std::chrono::duration_cast<Clock::duration>(
+                                         std::chrono::duration<double>(spacing * static_cast<double>(next)));
+                auto now = Clock::now();
+                if (due > now) {
+                    auto remaining = std::chrono::duration<double, std::milli>(due - now).count();
+                    wait_ms = std::max(1, static_cast<int>(std::ceil(remaining)));
+                    break;
+                }
+            }
+
+            // Limits are resolved per transfer, so each one only gets what is left of the deadline
+            const BatchRequest& batch_request = requests[next];
+            CallLimits limits;
+            try {
+                limits = call_limits(request, timeout_, *settings);
+            } catch (const DomeAPIError& e) {
+                results[next++].error = e;
+                continue;
+            }
+
+            if (queue.scheduler) {
+                if (permits.empty()) {
+                    size_t wanted = std::min(idle.size(), requests.size() - next);
+                    size_t missing = wanted > pending_permits ? wanted - pending_permits : 0;
+                    {
+                        std::lock_guard<std::mutex> lock(queue.admissions->mutex);
+                        queue.admissions->pending += missing;
+                    }
+                    for (size_t i = 0; i < missing; ++i) {
+                        std::shared_ptr<Admissions> inbox = queue.admissions;
+                        queue.tickets.push_back(queue.scheduler->enqueue(
+                            admission, [inbox](RequestScheduler::Permit permit) { inbox->admit(std::move(permit)); },
+                            [inbox] { inbox->expire(); }));
+                    }
+                    break;
+                }
+                idle.back()->permit = std::move(permits.back());
+                permits.pop_back();
+            }
+
+            if (settings->circuit_breaker) {
+                try {
+                    idle.back()->breaker.emplace(settings->circuit_breaker,
+                                                 CircuitBreaker::route_of(batch_request.endpoint));
+                } catch (const CircuitOpenError& e) {
+                    idle.back()->permit = RequestScheduler::Permit();
+                    results[next++].error = e;
+                    continue;
+                }
+            }
+
+            Transfer* transfer = idle.back();
+            idle.pop_back();
+            transfer->index = next;
+            transfer->running = true;
+            transfer->body.clear();
+            transfer->watch = TransferWatch(limits);
+            curl_easy_reset(transfer->handle);
+            configure_handle(transfer->handle, build_url(batch_request.endpoint, batch_request.query_params),
+                             *settings, limits, &transfer->body, extra_headers.get());
+            settings->pool->state_->attach(transfer->handle);
+            curl_easy_setopt(transfer->handle, CURLOPT_PRIVATE, transfer);
+            curl_multi_add_handle(batch.multi, transfer->handle);
+            ++next;
+            ++running;
+        }
+
+        int still_running = 0;
+        curl_multi_perform(batch.multi, &still_running);
+
+        size_t finished = 0;
+        int queued = 0;
+        while (CURLMsg* message = curl_multi_info_read(batch.multi, &queued)) {
+            if (message->msg != CURLMSG_DONE) {
+                continue;
+            }
+            char* user_data = nullptr;
+            curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &user_data);
+            Transfer* transfer = reinterpret_cast<Transfer*>(user_data);
+            long http_code = 0;
+            curl_easy_getinfo(message->easy_handle, CURLINFO_RESPONSE_CODE, &http_code);
+            CURLcode res = message->data.result;
+            record_transfer(settings->stats.get(), message->easy_handle, transfer->body.size());
+            curl_multi_remove_handle(batch.multi, transfer->handle);
+            transfer->running = false;
+            RequestOutcome outcome = classify_outcome(res, http_code, request);
+            transfer->permit.report(outcome);
+            transfer->permit = RequestScheduler::Permit();
+            if (transfer->breaker) {
+                transfer->breaker->report(outcome);
+                transfer->breaker.reset();
+            }
+
+            BatchResult& result = results[transfer->index];
+            try {
+                check_deadline(res, request);
+                check_response(res, http_code, transfer->body);
+                result.body = parse_response(transfer->body);
+            } catch (const DomeAPIError& e) {
+                result.error = e;
+            }
+            idle.push_back(transfer);
+            --running;
+            ++finished;
+        }
+
+        // Stop transfers that were cancelled or got no response within the first-byte timeout
+        for (auto& transfer : batch.transfers) {
+            if (!transfer.running) {
+                continue;
+            }
+            if (std::exception_ptr aborted = transfer.watch.check(transfer.handle)) {
+                curl_multi_remove_handle(batch.multi, transfer.handle);
+                transfer.running = false;
+                RequestOutcome outcome = classify_outcome(CURLE_ABORTED_BY_CALLBACK, 0, request);
+                transfer.permit.report(outcome);
+                transfer.permit = RequestScheduler::Permit();
+                if (transfer.breaker) {
+                    transfer.breaker->report(outcome);
+                    transfer.breaker.reset();
+                }
+                try {
+                    std::rethrow_exception(aborted);
+                } catch (const DomeAPIError& e) {
+                    results[transfer.index].error = e;
+                }
+                idle.push_back(&transfer);
+                --running;
+                ++finished;
+            } else {
+                wait_ms = transfer.watch.wait_ms(wait_ms);
+            }
+        }
+
+        // Freed transfers start the next requests right away
+        if (finished == 0 && (running > 0 || next < requests.size())) {
+            curl_multi_poll(batch.multi, nullptr, 0, wait_ms, nullptr);
+        }
+    }
+
+    return results;
+}
+
+// AsyncLoop
+
+struct AsyncLoop::Transfer {
+    CURL* curl = nullptr;
+    uint64_t id = 0;
+    std::string url;
+    std::string body;
+    std::shared_ptr<const RequestSettings> settings;  // outlives the handle using its header list and pool
+    RequestConfig request;
+    float client_timeout = 0;
+    HeaderList extra_headers{nullptr, &curl_slist_free_all};
+    std::string route;                        // circuit key, with a circuit breaker
+    std::optional<BreakerAdmission> breaker;  // from admission until the transfer ends
+    RequestScheduler::Permit permit;          // held while the transfer runs
+    uint64_t ticket = 0;                      // while waiting for the scheduler
+    TransferWatch watch;
+    std::optional<CancellationCallback> on_cancel;
+    AsyncCallback<nlohmann::json> callback;
+
+    ~Transfer() {
+        on_cancel.reset();
+        if (curl) curl_easy_cleanup(curl);
+    }
+};
+
+struct AsyncLoop::State {
+    // Scheduler decisions, which arrive on any thread and possibly after the loop is gone
+    struct Admissions {
+        std::mutex mutex;
+        CURLM* multi = nullptr;  // null once the loop is destroyed
+        std::vector<std::pair<Transfer*, RequestScheduler::Permit>> started;
+        std::vector<Transfer*> shed;
+        std::vector<uint64_t> cancelled;  // transfer ids
+
+        void admit(Transfer* transfer, RequestScheduler::Permit permit) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (multi) {
+                started.emplace_back(transfer, std::move(permit));
+                curl_multi_wakeup(multi);
+            }
+        }
+
+        void expire(Transfer* transfer) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (multi) {
+                shed.push_back(transfer);
+                curl_multi_wakeup(multi);
+            }
+        }
+
+        void cancel(uint64_t id) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (multi) {
+                cancelled.push_back(id);
+                curl_multi_wakeup(multi);
+            }
+        }
+    };
+
+    CURLM* multi = nullptr;
+    std::unordered_map<CURL*, std::unique_ptr<Transfer>> active;
+    std::unordered_map<Transfer*, std::unique_ptr<Transfer>> waiting;  // queued in a scheduler
+    std::shared_ptr<Admissions> admissions = std::make_shared<Admissions>();
+    std::atomic<size_t> pending{0};
+    uint64_t next_id = 1;
+
+    std::mutex mutex;  // guards executor, queued and stopping
+    std::shared_ptr<const Executor> executor;
+    std::vector<std::unique_ptr<Transfer>> queued;
+    bool stopping = false;
+
+    ~State() {
+        std::vector<std::pair<Transfer*, RequestScheduler::Permit>> started;
+        {
+            std::lock_guard<std::mutex> lock(admissions->mutex);
+            admissions->multi = nullptr;
+            started.swap(admissions->started);
+        }
+        started.clear();  // releasing permits may admit other requests into admissions
+        for (auto& [key, transfer] : waiting) {
+            transfer->settings->scheduler->cancel(transfer->ticket);
+        }
+        for (auto& [curl, transfer] : active) {
+            curl_multi_remove_handle(multi, curl);
+        }
+        active.clear();
+        if (multi) curl_multi_cleanup(multi);
+    }
+
+    // Hand a request to its scheduler, or start it right away without one. A request
+    // whose circuit is open fails here.
+    void admit(std::unique_ptr<Transfer> transfer) {
+        transfer->id = next_id++;
+        try {
+            transfer->breaker.emplace(transfer->settings->circuit_breaker, transfer->route);
+        } catch (...) {
+            complete(std::move(transfer), std::current_exception(), nlohmann::json());
+            return;
+        }
+        if (transfer->request.cancellation.can_be_cancelled()) {
+            std::shared_ptr<Admissions> inbox = admissions;
+            transfer->on_cancel.emplace(transfer->request.cancellation,
+                                        [inbox, id = transfer->id] { inbox->cancel(id); });
+        }
+        const auto& scheduler = transfer->settings->scheduler;
+        if (!scheduler) {
+            start(std::move(transfer));
+            return;
+        }
+        Transfer* raw = transfer.get();
+        waiting.emplace(raw, std::move(transfer));
+        std::shared_ptr<Admissions> inbox = admissions;
+        raw->ticket = scheduler->enqueue(
+            raw->request, [inbox, raw](RequestScheduler::Permit permit) { inbox->admit(raw, std::move(permit)); },
+            [inbox, raw] { inbox->expire(raw); });
+    }
+
+    // Configure the handle and add it to the multi; the request may already be
+    // cancelled or past its deadline
+    void start(std::unique_ptr<Transfer> transfer) {
+        const RequestSettings& settings = *transfer->settings;
+        CallLimits limits;
+        try {
+            limits = call_limits(transfer->request, transfer->client_timeout, settings);
+        } catch (...) {
+            complete(std::move(transfer), std::current_exception(), nlohmann::json());
+            return;
+        }
+        transfer->watch = TransferWatch(limits);
+        transfer->extra_headers = call_headers(settings, transfer->request);
+        configure_handle(transfer->curl, transfer->url, settings, limits, &transfer->body,
+                         transfer->extra_headers.get());
+        settings.pool->state_->attach(transfer->curl);
+        CURL* curl = transfer->curl;
+        curl_multi_add_handle(multi, curl);
+        active.emplace(curl, std::move(transfer));
+    }
+
+    // Start transfers the schedulers admitted, fail the ones they shed and stop
+    // cancelled ones
+    void collect_admissions() {
+        std::vector<std::pair<Transfer*, RequestScheduler::Permit>> started;
+        std::vector<Transfer*> shed;
+        std::vector<uint64_t> cancelled;
+        {
+            std::lock_guard<std::mutex> lock(admissions->mutex);
+            started.swap(admissions->started);
+            shed.swap(admissions->shed);
+            cancelled.swap(admissions->cancelled);
+        }
+        for (uint64_t id : cancelled) {
+            cancel(id);
+        }
+        for (auto& [raw, permit] : started) {
+            auto it = waiting.find(raw);
+            if (it == waiting.end()) {
+                continue;
+            }
+            std::unique_ptr<Transfer> transfer = std::move(it->second);
+            waiting.erase(it);
+            transfer->permit = std::move(permit);
+            start(std::move(transfer));
+        }
+        for (Transfer* raw : shed) {
+            fail_waiting(raw);
+        }
+
+        // Deadlines pass without any permit being released; shed those requests here
+        auto now = std::chrono::steady_clock::now();
+        std::vector<Transfer*> overdue;
+        for (auto& [raw, transfer] : waiting) {
+            if (transfer->request.deadline && *transfer->request.deadline <= now &&
+                transfer->settings->scheduler->cancel(transfer->ticket)) {
+                overdue.push_back(raw);
+            }
+        }
+        for (Transfer* raw : overdue) {
+            fail_waiting(raw);
+        }
+    }
+
+    // timeout, shortened so that run_once wakes up at the next waiting deadline or
+    // first-byte timeout
+    std::chrono::milliseconds poll_timeout(std::chrono::milliseconds timeout) const {
+        auto now = Clock::now();
+        for (const auto& [raw, transfer] : waiting) {
+            if (transfer->request.deadline) {
+                auto until = std::chrono::ceil<std::chrono::milliseconds>(*transfer->request.deadline - now);
+                timeout = std::max(std::chrono::milliseconds(0), std::min(timeout, until));
+            }
+        }
+        for (const auto& [curl, transfer] : active) {
+            timeout = std::chrono::milliseconds(transfer->watch.wait_ms(static_cast<int>(timeout.count())));
+        }
+        return timeout;
+    }
+
+    // Stop a cancelled transfer wherever it is; one admitted concurrently is
+    // stopped by start() instead
+    void cancel(uint64_t id) {
+        for (auto& [raw, transfer] : waiting) {
+            if (transfer->id == id) {
+                if (transfer->settings->scheduler->cancel(transfer->ticket)) {
+                    Transfer* key = raw;
+                    std::unique_ptr<Transfer> cancelled = std::move(transfer);
+                    waiting.erase(key);
+                    complete(std::move(cancelled), std::make_exception_ptr(request_cancelled_error()),
+                             nlohmann::json());
+                }
+                return;
+            }
+        }
+        for (auto& [curl, transfer] : active) {
+            if (transfer->id == id) {
+                abort(curl, std::make_exception_ptr(request_cancelled_error()));
+                return;
+            }
+        }
+    }
+
+    // Remove a running transfer from the multi and complete it with error
+    void abort(CURL* curl, std::exception_ptr error) {
+        auto it = active.find(curl);
+        std::unique_ptr<Transfer> transfer = std::move(it->second);
+        active.erase(it);
+        curl_multi_remove_handle(multi, curl);
+        record_transfer(transfer->settings->stats.get(), curl, transfer->body.size());
+        report(*transfer, classify_outcome(CURLE_ABORTED_BY_CALLBACK, 0, transfer->request));
+        complete(std::move(transfer), error, nlohmann::json());
+    }
+
+    // Abort running transfers that are past their first-byte timeout; returns how many
+    size_t check_watches() {
+        std::vector<std::pair<CURL*, std::exception_ptr>> expired;
+        for (auto& [curl, transfer] : active) {
+            if (auto error = transfer->watch.check(curl)) {
+                expired.emplace_back(curl, error);
+            }
+        }
+        for (auto& [curl, error] : expired) {
+            abort(curl, error);
+        }
+        return expired.size();
+    }
+
+    // Tell the scheduler and the circuit breaker how a transfer went
+    static void report(Transfer& transfer, RequestOutcome outcome) {
+        transfer.permit.report(outcome);
+        transfer.breaker->report(outcome);
+    }
+
+    void fail_waiting(Transfer* raw) {
+        auto it = waiting.find(raw);
+        if (it == waiting.end()) {
+            return;
+        }
+        std::unique_ptr<Transfer> transfer = std::move(it->second);
+        waiting.erase(it);
+        complete(std::move(transfer), std::make_exception_ptr(deadline_exceeded_error()), nlohmann::json());
+    }
+
+    // Release the transfer and run its completion
+    void complete(std::unique_ptr<Transfer> transfer, std::exception_ptr error, nlohmann::json body) {
+        AsyncCallback<nlohmann::json> callback = std::move(transfer->callback);
+        transfer.reset();
+        --pending;
+        std::shared_ptr<const Executor> run;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            run = executor;
+        }
+        if (run) {
+            (*run)([callback, error, body = std::move(body)]() mutable {
+                callback(error, std::move(body));
+            });
+        } else {
+            callback(error, std::move(body));
+        }
+    }
+};
+
+AsyncLoop::AsyncLoop(size_t max_host_connections) : state_(std::make_unique<State>()) {
+    ensure_curl_initialized();
+    state_->multi = curl_multi_init();
+    if (!state_->multi) {
+        throw DomeAPIError(-1, "Failed to initialize CURL multi handle");
+    }
+    state_->admissions->multi = state_->multi;
+    long connections = static_cast<long>(std::max<size_t>(1, max_host_connections));
+    curl_multi_setopt(state_->multi, CURLMOPT_MAX_HOST_CONNECTIONS, connections);
+    curl_multi_setopt(state_->multi, CURLMOPT_MAXCONNECTS, connections);
+    curl_multi_setopt(state_->multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+}
+
+AsyncLoop::~AsyncLoop() = default;
+
+void AsyncLoop::set_executor(Executor executor) {
+    auto next = executor ? std::make_shared<const Executor>(std::move(executor)) : nullptr;
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->executor = std::move(next);
+}
+
+size_t AsyncLoop::pending() const {
+    return state_->pending.load();
+}
+
+void AsyncLoop::submit(std::unique_ptr<Transfer> transfer) {
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->queued.push_back(std::move(transfer));
+    }
+    ++state_->pending;
+    curl_multi_wakeup(state_->multi);
+}
+
+void AsyncLoop::stop() {
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->stopping = true;
+    }
+    curl_multi_wakeup(state_->multi);
+}
+
+size_t AsyncLoop::run_once(std::chrono::milliseconds timeout) {
+    State& state = *state_;
+
+    std::vector<std::unique_ptr<Transfer>> queued;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        queued.swap(state.queued);
+    }
+    for (auto& transfer : queued) {
+        state.admit(std::move(transfer));
+    }
+    state.collect_admissions();
+
+    // Perform, and if nothing finished wait for activity (or a wakeup) and perform again
+    size_t completed = 0;
+    for (int pass = 0; pass < 2 && completed == 0; ++pass) {
+        if (pass == 1) {
+            curl_multi_poll(state.multi, nullptr, 0, static_cast<int>(state.poll_timeout(timeout).count()), nullptr);
+            state.collect_admissions();
+        }
+        int running = 0;
+        curl_multi_perform(state.multi, &running);
+
+        int remaining = 0;
+        while (CURLMsg* message = curl_multi_info_read(state.multi, &remaining)) {
+            if (message->msg != CURLMSG_DONE) {
+                continue;
+            }
+            auto it = state.active.find(message->easy_handle);
+            if (it == state.active.end()) {
+                continue;
+            }
+            std::unique_ptr<Transfer> transfer = std::move(it->second);
+            state.active.erase(it);
+            CURLcode res = message->data.result;
+            curl_multi_remove_handle(state.multi, transfer->curl);
+
+            long http_code = 0;
+            curl_easy_getinfo(transfer->curl, CURLINFO_RESPONSE_CODE, &http_code);
+            record_transfer(transfer->settings->stats.get(), transfer->curl, transfer->body.size());
+            state.report(*transfer, classify_outcome(res, http_code, transfer->request));
+
+            std::exception_ptr error;
+            nlohmann::json body;
+            try {
+                check_deadline(res, transfer->request);
+                check_response(res, http_code, transfer->body);
+                body = parse_response(transfer->body);
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            ++completed;
+            state.complete(std::move(transfer), error, std::move(body));
+        }
+        completed += state.check_watches();
+    }
+    return state.pending.load();
+}
+
+void AsyncLoop::run() {
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            if (state_->stopping) {
+                state_->stopping = false;
+                return;
+            }
+        }
+        if (run_once() == 0) {
+            return;
+        }
+    }
+}
+
+AsyncOp<nlohmann::json> HttpClient::get_async(AsyncLoop& loop, const std::string& endpoint,
+                                              const std::map<std::string, std::string>& query_params,
+                                              const RequestConfig& request) {
+    return AsyncOp<nlohmann::json>(
+        [&loop, url = build_url(endpoint, query_params), settings = settings(), request, timeout = timeout_,
+         endpoint](AsyncCallback<nlohmann::json> callback) {
+            auto transfer = std::make_unique<AsyncLoop::Transfer>();
+            transfer->curl = curl_easy_init();
+            if (!transfer->curl) {
+                throw DomeAPIError(-1, "Failed to initialize CURL");
+            }
+            transfer->url = url;
+            transfer->route = breaker_route(*settings, endpoint);
+            transfer->settings = settings;
+            transfer->request = request;
+            transfer->client_timeout = timeout;
+            transfer->callback = std::move(callback);
+            loop.submit(std::move(transfer));
+        });
 }
 
 }  // namespace dome
@@ -0,0 +1,216 @@
+#include "dome_api_sdk/identifiers.hpp"
+#include "dome_api_sdk/wide_int.hpp"
+
+#include <algorithm>
+
+#if defined(__SSE2__) && !defined(DOME_FORCE_SCALAR)
+#include <emmintrin.h>
+#endif
+
+namespace dome {
+
+// Hex
+
+static inline int hex_value(unsigned char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    unsigned char lower = c | 0x20;
+    if (lower >= 'a' && lower <= 'f') return lower - 'a' + 10;
+    return -1;
+}
+
+#if defined(__SSE2__) && !defined(DOME_FORCE_SCALAR)
+// Decode 32 hex digits into 16 bytes; returns false if any character is not a hex digit
+static inline bool decode_hex_block(const char* in, uint8_t* out) {
+    const __m128i zero_char = _mm_set1_epi8('0' - 1);
+    const __m128i nine_char = _mm_set1_epi8('9' + 1);
+    const __m128i a_char = _mm_set1_epi8('a' - 1);
+    const __m128i f_char = _mm_set1_epi8('f' + 1);
+    const __m128i case_bit = _mm_set1_epi8(0x20);
+    const __m128i low_byte = _mm_set1_epi16(0x00FF);
+
+    __m128i packed[2];
+    for (int half = 0; half < 2; ++half) {
+        __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + half * 16));
+        __m128i lower = _mm_or_si128(chars, case_bit);
+
+        __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(chars, zero_char), _mm_cmplt_epi8(chars, nine_char));
+        __m128i is_alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, a_char), _mm_cmplt_epi8(lower, f_char));
+        if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) != 0xFFFF) {
+            return false;
+        }
+
+        __m128i digits = _mm_and_si128(is_digit, _mm_sub_epi8(chars, _mm_set1_epi8('0')));
+        __m128i letters = _mm_and_si128(is_alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)));
+        __m128i nibbles = _mm_or_si128(digits, letters);
+
+        // Each 16-bit lane holds (high nibble, low nibble); fold to one byte per lane
+        __m128i high = _mm_slli_epi16(_mm_and_si128(nibbles, low_byte), 4);
+        __m128i low = _mm_srli_epi16(nibbles, 8);
+        packed[half] = _mm_or_si128(high, low);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(packed[0], packed[1]));
+    return true;
+}
+#endif
+
+bool decode_hex(std::string_view text, uint8_t* out, size_t size) {
+    if (text.size() >= 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+        text.remove_prefix(2);
+    }
+    if (text.size() != size * 2) {
+        return false;
+    }
+
+    const char* in = text.data();
+    size_t i = 0;
+#if defined(__SSE2__) && !defined(DOME_FORCE_SCALAR)
+    for (; i + 16 <= size; i += 16) {
+        if (!decode_hex_block(in + i * 2, out + i)) {
+            return false;
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        int high = hex_value(static_cast<unsigned char>(in[i * 2]));
+        int low = hex_value(static_cast<unsigned char>(in[i * 2 + 1]));
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        out[i] = static_cast<uint8_t>((high << 4) | low);
+    }
+    return true;
+}
+
+std::string encode_hex(const uint8_t* data, size_t size) {
+    static const char digits[] = "0123456789abcdef";
+    std::string out(2 + size * 2, '0');
+    out[1] = 'x';
+    for (size_t i = 0; i < size; ++i) {
+        out[2 + i * 2] = digits[data[i] >> 4];
+        out[3 + i * 2] = digits[data[i] & 0x0F];
+    }
+    return out;
+}
+
+// Uint256
+
+static constexpr uint64_t kPow10[] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+};
+
+// Value of 8 ASCII digits, or -1 if any byte is not a digit
+static inline int64_t parse_eight_digits(const char* in) {
+    uint64_t chunk;
+    std::memcpy(&chunk, in, 8);
+    // Every byte must lie in '0'..'9'
+    if ((((chunk + 0x4646464646464646ull) | (chunk - 0x3030303030303030ull)) & 0x8080808080808080ull) != 0) {
+        return -1;
+    }
+    chunk -= 0x3030303030303030ull;
+    chunk = (chunk * 10) + (chunk >> 8);  // pairs
+    chunk = (((chunk & 0x000000FF000000FFull) * (100ull + (1000000ull << 32))) +
+             (((chunk >> 16) & 0x000000FF000000FFull) * (1ull + (10000ull << 32)))) >> 32;
+    return static_cast<int64_t>(chunk);
+}
+
+// limbs = limbs * multiplier + addend over the used low limbs; returns false on overflow
+static inline bool multiply_add(std::array<uint64_t, 4>& limbs, size_t& used, uint64_t multiplier, uint64_t addend) {
+    uint64_t carry = addend;
+    for (size_t i = 0; i < used; ++i) {
+        Uint128 product = mul_wide(limbs[i], multiplier, carry);
+        limbs[i] = product.low;
+        carry = product.high;
+    }
+    if (carry != 0) {
+        if (used == limbs.size()) {
+            return false;
+        }
+        limbs[used++] = carry;
+    }
+    return true;
+}
+
+bool Uint256::try_parse(std::string_view text, Uint256& out) {
+    if (text.empty() || text.size() > 78) {
+        return false;
+    }
+
+    std::array<uint64_t, 4> limbs{};
+    size_t used = 1;
+    const char* in = text.data();
+    size_t remaining = text.size();
+
+    // Leading partial chunk so the rest is whole 8-digit chunks
+    size_t head = remaining % 8;
+    for (size_t i = 0; i < head; ++i) {
+        unsigned char c = static_cast<unsigned char>(in[i]);
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        limbs[0] = limbs[0] * 10 + (c - '0');
+    }
+    in += head;
+    remaining -= head;
+
+    // Fold two 8-digit chunks per 256-bit multiply
+    for (; remaining >= 16; remaining -= 16, in += 16) {
+        int64_t high = parse_eight_digits(in);
+        int64_t low = parse_eight_digits(in + 8);
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        uint64_t chunk = static_cast<uint64_t>(high) * kPow10[8] + static_cast<uint64_t>(low);
+        if (!multiply_add(limbs, used, kPow10[8] * kPow10[8], chunk)) {
+            return false;
+        }
+    }
+    if (remaining > 0) {
+        int64_t chunk = parse_eight_digits(in);
+        if (chunk < 0 || !multiply_add(limbs, used, kPow10[8], static_cast<uint64_t>(chunk))) {
+            return false;
+        }
+    }
+    out = Uint256(limbs);
+    return true;
+}
+
+Uint256 Uint256::parse(std::string_view text) {
+    Uint256 out;
+    if (!try_parse(text, out)) {
+        bool digits = !text.empty() && std::all_of(text.begin(), text.end(),
+                                                   [](char c) { return c >= '0' && c <= '9'; });
+        if (digits) {
+            throw std::out_of_range("Integer exceeds 256 bits: " + std::string(text));
+        }
+        throw std::invalid_argument("Invalid unsigned integer: " + std::string(text));
+    }
+    return out;
+}
+
+std::string Uint256::to_string() const {
+    if (is_zero()) {
+        return "0";
+    }
+
+    // Peel off 19 digits at a time by dividing by 10^19
+    constexpr uint64_t kChunk = 10000000000000000000ull;
+    std::array<uint64_t, 4> value = limbs_;
+    std::string out;
+    out.reserve(78);
+    while ((value[0] | value[1] | value[2] | value[3]) != 0) {
+        uint64_t remainder = 0;
+        for (size_t i = 4; i-- > 0;) {
+            value[i] = div_wide({remainder, value[i]}, kChunk, remainder);
+        }
+        uint64_t chunk = remainder;
+        bool last = (value[0] | value[1] | value[2] | value[3]) == 0;
+        for (int digit = 0; digit < 19 && (!last || chunk != 0); ++digit) {
+            out.push_back(static_cast<char>('0' + chunk % 10));
+            chunk /= 10;
+        }
+    }
+    std::reverse(out.begin(), out.end());
+    return out;
+}
+
+}  // namespace dome
@@ -0,0 +1,299 @@
+#include "dome_api_sdk/incremental_poller.hpp"
+#include "dome_api_sdk/identifiers.hpp"
+#include "dome_api_sdk/pager.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace dome {
+
+// Identity of a record. An order fill is its order and transaction. Activity rows
+// (MERGE, SPLIT, REDEEM) have no order hash, so they are their transaction, token,
+// side and shares; the other fields stay empty.
+struct RecordKey {
+    Hash32 order_hash;
+    Hash32 tx_hash;
+    Uint256 token_id;
+    std::string side;
+    int64_t shares = 0;
+
+    bool operator==(const RecordKey& other) const {
+        return order_hash == other.order_hash && tx_hash == other.tx_hash && token_id == other.token_id &&
+               side == other.side && shares == other.shares;
+    }
+};
+
+struct RecordKeyHash {
+    size_t operator()(const RecordKey& key) const {
+        size_t h = key.order_hash.hash() ^ (key.tx_hash.hash() * 0x9E3779B97F4A7C15ull);
+        h ^= key.token_id.hash() * 0xC2B2AE3D27D4EB4Full;
+        return h ^ std::hash<std::string>()(key.side) ^ (static_cast<size_t>(key.shares) * 0x165667B19E3779F9ull);
+    }
+};
+
+// Malformed hashes and token IDs parse as zero and only dedupe against each other
+static RecordKey key_of(const Order& order) {
+    RecordKey key;
+    Hash32::try_parse(order.order_hash, key.order_hash);
+    Hash32::try_parse(order.tx_hash, key.tx_hash);
+    return key;
+}
+
+static RecordKey key_of(const Activity& activity) {
+    RecordKey key;
+    Hash32::try_parse(activity.tx_hash, key.tx_hash);
+    Uint256::try_parse(activity.token_id.str(), key.token_id);
+    key.side = activity.side;
+    key.shares = activity.shares;
+    return key;
+}
+
+static int64_t now_seconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+struct IncrementalPoller::Watch {
+    std::string id;
+    std::optional<GetOrdersParams> orders;
+    OrderEventCallback on_order;
+    std::optional<GetActivityParams> activity;
+    ActivityCallback on_activity;
+
+    // High-watermark; written under poll_mutex_
+    std::atomic<int64_t> high{0};
+    std::unordered_map<RecordKey, int64_t, RecordKeyHash> seen;  // key -> timestamp, within the overlap
+
+    // Records at or after start_time() not delivered yet, oldest first
+    template<typename Record>
+    std::vector<Record> take_new(std::vector<Record> records, std::chrono::seconds overlap) const {
+        int64_t from = start_time(overlap);
+        std::unordered_set<RecordKey, RecordKeyHash> batch;
+        std::vector<Record> fresh;
+        for (auto& record : records) {
+            if (record.timestamp < from) {
+                continue;
+            }
+            // Also drops duplicates within the batch, which offset paging can produce
+            RecordKey key = key_of(record);
+            if (seen.count(key) == 0 && batch.insert(std::move(key)).second) {
+                fresh.push_back(std::move(record));
+            }
+        }
+        std::stable_sort(fresh.begin(), fresh.end(),
+                         [](const Record& a, const Record& b) { return a.timestamp < b.timestamp; });
+        return fresh;
+    }
+
+    // Record that a callback returned for record and advance the watermark to it, so
+    // a callback throwing part way through a batch loses none of the rest
+    template<typename Record>
+    void mark_delivered(const Record& record) {
+        seen.emplace(key_of(record), record.timestamp);
+        if (record.timestamp > high) {
+            high = record.timestamp;
+        }
+    }
+
+    // Forget delivered records that fell out of the overlap window
+    void prune(std::chrono::seconds overlap) {
+        int64_t keep_from = start_time(overlap);
+        for (auto it = seen.begin(); it != seen.end();) {
+            it = it->second < keep_from ? seen.erase(it) : std::next(it);
+        }
+    }
+
+    int64_t start_time(std::chrono::seconds overlap) const { return high - overlap.count(); }
+};
+
+IncrementalPoller::IncrementalPoller(OrdersEndpoints& orders, ActivityEndpoints& activity,
+                                     IncrementalPollerOptions options)
+    : orders_(orders), activity_(activity), options_(options) {
+    options_.page_size = std::clamp(options_.page_size, 1, 1000);
+    options_.overlap = std::max(options_.overlap, std::chrono::seconds(0));
+}
+
+IncrementalPoller::IncrementalPoller(PolymarketClient& polymarket, IncrementalPollerOptions options)
+    : IncrementalPoller(polymarket.orders, polymarket.activity, options) {}
+
+IncrementalPoller::~IncrementalPoller() {
+    stop();
+}
+
+std::string IncrementalPoller::watch_orders(const GetOrdersParams& filter, OrderEventCallback callback,
+                                            std::optional<int64_t> since) {
+    auto watch = std::make_shared<Watch>();
+    watch->orders = filter;
+    watch->on_order = std::move(callback);
+    watch->high = since.value_or(now_seconds());
+    return add(std::move(watch));
+}
+
+std::string IncrementalPoller::watch_activity(const GetActivityParams& filter, ActivityCallback callback,
+                                              std::optional<int64_t> since) {
+    auto watch = std::make_shared<Watch>();
+    watch->activity = filter;
+    watch->on_activity = std::move(callback);
+    watch->high = since.value_or(now_seconds());
+    return add(std::move(watch));
+}
+
+std::string IncrementalPoller::add(std::shared_ptr<Watch> watch) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    watch->id = "poll-" + std::to_string(next_id_++);
+    std::string id = watch->id;
+    watches_.emplace(id, std::move(watch));
+    return id;
+}
+
+bool IncrementalPoller::unwatch(const std::string& watch_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return watches_.erase(watch_id) > 0;
+}
+
+size_t IncrementalPoller::poll_watch(Watch& watch) {
+    const int64_t from = watch.start_time(options_.overlap);
+    size_t delivered = 0;
+
+    if (watch.orders) {
+        GetOrdersParams params = *watch.orders;
+        params.start_time = from;
+        params.end_time.reset();
+        params.offset.reset();
+        std::vector<Order> orders = fetch_all_pages(
+            std::move(params), options_.page_size,
+            [this](const GetOrdersParams& page) { return orders_.get_orders(page); }, &OrdersResponse::orders);
+
+        WebSocketOrderEvent event;
+        event.type = "event";
+        event.subscription_id = watch.id;
+        for (auto& order : watch.take_new(std::move(orders), options_.overlap)) {
+            event.data = std::move(order);
+            if (watch.on_order) {
+                watch.on_order(event);
+            }
+            watch.mark_delivered(event.data);
+            ++delivered;
+        }
+        watch.prune(options_.overlap);
+    }
+
+    if (watch.activity) {
+        GetActivityParams params = *watch.activity;
+        params.start_time = from;
+        params.end_time.reset();
+        params.offset.reset();
+        std::vector<Activity> activities = fetch_all_pages(
+            std::move(params), options_.page_size,
+            [this](const GetActivityParams& page) { return activity_.get_activity(page); },
+            &ActivityResponse::activities);
+
+        for (const auto& activity : watch.take_new(std::move(activities), options_.overlap)) {
+            if (watch.on_activity) {
+                watch.on_activity(activity);
+            }
+            watch.mark_delivered(activity);
+            ++delivered;
+        }
+        watch.prune(options_.overlap);
+    }
+    return delivered;
+}
+
+size_t IncrementalPoller::poll() {
+    std::lock_guard<std::mutex> poll_lock(poll_mutex_);
+    std::vector<std::shared_ptr<Watch>> watches;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [id, watch] : watches_) {
+            watches.push_back(watch);
+        }
+    }
+
+    size_t delivered = 0;
+    std::optional<DomeAPIError> first_error;
+    auto report = [&](const std::string& watch_id, const DomeAPIError& error) {
+        ErrorCallback callback;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            callback = error_callback_;
+        }
+        if (callback) {
+            callback(watch_id, error);
+        } else if (!first_error) {
+            first_error = error;
+        }
+    };
+    for (const auto& watch : watches) {
+        try {
+            delivered += poll_watch(*watch);
+        } catch (const DomeAPIError& e) {
+            report(watch->id, e);
+        } catch (const std::exception& e) {
+            // E.g. a malformed response the decoder rejected, or a throwing callback
+            report(watch->id, DomeAPIError(-1, std::string("Poll failed: ") + e.what()));
+        }
+    }
+    if (first_error) {
+        throw *first_error;
+    }
+    return delivered;
+}
+
+void IncrementalPoller::start() {
+    std::lock_guard<std::mutex> lock(thread_mutex_);
+    if (poll_thread_.joinable()) {
+        return;
+    }
+    stopping_ = false;
+    poll_thread_ = std::thread(&IncrementalPoller::poll_loop, this);
+}
+
+void IncrementalPoller::stop() {
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(thread_mutex_);
+        stopping_ = true;
+        thread = std::move(poll_thread_);
+    }
+    stop_cv_.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void IncrementalPoller::set_error_callback(ErrorCallback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    error_callback_ = std::move(callback);
+}
+
+std::optional<int64_t> IncrementalPoller::watermark(const std::string& watch_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = watches_.find(watch_id);
+    if (it == watches_.end()) {
+        return std::nullopt;
+    }
+    return it->second->high.load();
+}
+
+void IncrementalPoller::poll_loop() {
+    std::unique_lock<std::mutex> lock(thread_mutex_);
+    while (true) {
+        lock.unlock();
+        try {
+            poll();
+        } catch (const std::exception&) {
+            // No error callback, or it threw; the watermarks stay put and the next poll retries
+        }
+        lock.lock();
+        if (stop_cv_.wait_for(lock, options_.interval, [this] { return stopping_; })) {
+            return;
+        }
+    }
+}
+
+}  // namespace dome
@@ -0,0 +1,55 @@
+#include "dome_api_sdk/intern.hpp"
+
+#include <mutex>
+
+namespace dome {
+
+InternedString InternTable::intern(std::string_view value) {
+    if (value.empty()) {
+        return InternedString();
+    }
+
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = entries_.find(value);
+        if (it != entries_.end()) {
+            return InternedString(it->second);
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = entries_.find(value);
+    if (it != entries_.end()) {
+        return InternedString(it->second);
+    }
+
+    auto stored = std::make_shared<const std::string>(value);
+    entries_.emplace(std::string_view(*stored), stored);
+    return InternedString(std::move(stored));
+}
+
+size_t InternTable::prune() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    size_t removed = 0;
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->second.use_count() == 1) {
+            it = entries_.erase(it);
+            ++removed;
+        } else {
+            ++it;
+        }
+    }
+    return removed;
+}
+
+void InternTable::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    entries_.clear();
+}
+
+size_t InternTable::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return entries_.size();
+}
+
+}  // namespace dome
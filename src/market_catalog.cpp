@@ -0,0 +1,277 @@
+#include "dome_api_sdk/market_catalog.hpp"
+#include "dome_api_sdk/pager.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace dome {
+
+// Status given to markets that left the open set but could not be found by slug
+static const char* const kStatusUnknown = "unknown";
+
+// MarketCatalogSnapshot
+
+static const std::vector<const Market*>& find_list(
+    const std::unordered_map<std::string, std::vector<const Market*>>& index, const std::string& key) {
+    static const std::vector<const Market*> empty;
+    auto it = index.find(key);
+    return it == index.end() ? empty : it->second;
+}
+
+void MarketCatalogSnapshot::index() {
+    const auto& markets = tokens_.markets();
+    by_slug_.reserve(markets.size());
+    by_condition_id_.reserve(markets.size());
+    for (size_t i = 0; i < markets.size(); ++i) {
+        const Market& market = markets[i];
+        if (!market.market_slug.empty()) by_slug_[market.market_slug] = i;
+        if (!market.condition_id.empty()) by_condition_id_[market.condition_id] = i;
+        for (const auto& tag : market.tags) {
+            by_tag_[tag].push_back(&market);
+        }
+        by_status_[market.status].push_back(&market);
+    }
+}
+
+const Market* MarketCatalogSnapshot::by_slug(const std::string& market_slug) const {
+    auto it = by_slug_.find(market_slug);
+    return it == by_slug_.end() ? nullptr : &markets()[it->second];
+}
+
+const Market* MarketCatalogSnapshot::by_condition_id(const std::string& condition_id) const {
+    auto it = by_condition_id_.find(condition_id);
+    return it == by_condition_id_.end() ? nullptr : &markets()[it->second];
+}
+
+const Market* MarketCatalogSnapshot::by_token_id(const std::string& token_id, const MarketSide** side) const {
+    TokenMatch match = tokens_.find(token_id);
+    if (match && side) {
+        *side = match.side;
+    }
+    return match.market;
+}
+
+const std::vector<const Market*>& MarketCatalogSnapshot::with_tag(const std::string& tag) const {
+    return find_list(by_tag_, tag);
+}
+
+const std::vector<const Market*>& MarketCatalogSnapshot::with_status(const std::string& status) const {
+    return find_list(by_status_, status);
+}
+
+// MarketCatalog
+
+MarketCatalog::MarketCatalog(MarketEndpoints& endpoints, MarketCatalogOptions options)
+    : endpoints_(endpoints), options_(std::move(options)),
+      snapshot_(std::make_shared<MarketCatalogSnapshot>()) {
+    if (options_.page_size <= 0 || options_.page_size > 100) {
+        options_.page_size = 100;
+    }
+}
+
+MarketCatalog::~MarketCatalog() {
+    stop_auto_refresh();
+}
+
+std::vector<Market> MarketCatalog::fetch_all(GetMarketsParams params) {
+    params.offset.reset();
+    return fetch_all_pages(std::move(params), options_.page_size,
+                           [this](const GetMarketsParams& page) { return endpoints_.get_markets(page); },
+                           &MarketsResponse::markets);
+}
+
+void MarketCatalog::publish(std::vector<Market> markets) {
+    auto next = std::make_shared<MarketCatalogSnapshot>();
+    next->tokens_ = TokenIndex(std::move(markets));
+    next->index();
+    next->loaded_at_ = std::chrono::system_clock::now();
+    std::atomic_store(&snapshot_, std::shared_ptr<const MarketCatalogSnapshot>(std::move(next)));
+}
+
+void MarketCatalog::load() {
+    std::lock_guard<std::mutex> lock(refresh_mutex_);
+    publish(fetch_all(options_.filter));
+}
+
+void MarketCatalog::refresh() {
+    std::lock_guard<std::mutex> lock(refresh_mutex_);
+    auto current = snapshot();
+    if (current->size() == 0) {
+        publish(fetch_all(options_.filter));
+        return;
+    }
+    // A filter on closed markets has nothing to refresh incrementally
+    if (options_.filter.status.has_value() && *options_.filter.status != "open") {
+        return;
+    }
+
+    GetMarketsParams open_filter = options_.filter;
+    open_filter.status = "open";
+    std::vector<Market> open = fetch_all(open_filter);
+
+    std::vector<Market> markets = current->markets();
+    std::unordered_map<std::string, size_t> positions;
+    positions.reserve(markets.size());
+    for (size_t i = 0; i < markets.size(); ++i) {
+        positions[markets[i].condition_id] = i;
+    }
+
+    std::unordered_set<std::string> still_open;
+    still_open.reserve(open.size());
+    for (auto& market : open) {
+        still_open.insert(market.condition_id);
+        auto it = positions.find(market.condition_id);
+        if (it == positions.end()) {
+            positions[market.condition_id] = markets.size();
+            markets.push_back(std::move(market));
+        } else {
+            markets[it->second] = std::move(market);
+        }
+    }
+
+    // Markets that left the open set were closed or resolved since the last read. Look
+    // them up by slug a page at a time. A failed page is retried one slug at a time, and
+    // a market whose own lookup fails stays as it was (to retry next time) without
+    // holding back the rest of the refresh.
+    std::vector<size_t> dropped;
+    for (size_t i = 0; i < markets.size(); ++i) {
+        const Market& market = markets[i];
+        if (market.status != "open" || still_open.count(market.condition_id) > 0) {
+            continue;
+        }
+        if (market.market_slug.empty()) {
+            markets[i].status = kStatusUnknown;
+        } else {
+            dropped.push_back(i);
+        }
+    }
+
+    std::optional<DomeAPIError> first_error;
+    // Update markets[dropped[begin..end)] from one lookup; false if it failed
+    auto look_up = [&](size_t begin, size_t end) {
+        GetMarketsParams by_slug;
+        by_slug.market_slugs.emplace();
+        for (size_t i = begin; i < end; ++i) {
+            by_slug.market_slugs->push_back(markets[dropped[i]].market_slug);
+        }
+        std::vector<Market> found;
+        try {
+            found = fetch_all(by_slug);
+        } catch (const DomeAPIError& e) {
+            if (!first_error) first_error = e;
+            return false;
+        } catch (const std::exception& e) {
+            if (!first_error) first_error = DomeAPIError(-1, std::string("Market lookup failed: ") + e.what());
+            return false;
+        }
+
+        std::unordered_map<std::string, Market*> found_by_slug;
+        for (auto& market : found) {
+            found_by_slug[market.market_slug] = &market;
+        }
+        for (size_t i = begin; i < end; ++i) {
+            Market& market = markets[dropped[i]];
+            auto it = found_by_slug.find(market.market_slug);
+            if (it == found_by_slug.end()) {
+                market.status = kStatusUnknown;
+            } else {
+                market = std::move(*it->second);
+            }
+        }
+        return true;
+    };
+
+    const size_t page_size = static_cast<size_t>(options_.page_size);
+    for (size_t begin = 0; begin < dropped.size(); begin += page_size) {
+        size_t end = std::min(begin + page_size, dropped.size());
+        if (!look_up(begin, end) && end - begin > 1) {
+            for (size_t i = begin; i < end; ++i) {
+                look_up(i, i + 1);
+            }
+        }
+    }
+
+    publish(std::move(markets));
+    if (first_error) {
+        throw *first_error;
+    }
+}
+
+void MarketCatalog::start_auto_refresh() {
+    std::lock_guard<std::mutex> lock(thread_mutex_);
+    if (refresh_thread_.joinable()) {
+        return;
+    }
+    stopping_ = false;
+    refresh_thread_ = std::thread(&MarketCatalog::refresh_loop, this);
+}
+
+void MarketCatalog::stop_auto_refresh() {
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(thread_mutex_);
+        stopping_ = true;
+        thread = std::move(refresh_thread_);
+    }
+    stop_cv_.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void MarketCatalog::set_refresh_error_callback(RefreshErrorCallback callback) {
+    std::lock_guard<std::mutex> lock(thread_mutex_);
+    error_callback_ = std::move(callback);
+}
+
+void MarketCatalog::refresh_loop() {
+    std::unique_lock<std::mutex> lock(thread_mutex_);
+    while (!stop_cv_.wait_for(lock, options_.refresh_interval, [this] { return stopping_; })) {
+        lock.unlock();
+        std::optional<DomeAPIError> error;
+        try {
+            refresh();
+        } catch (const DomeAPIError& e) {
+            error = e;
+        } catch (const std::exception& e) {
+            // e.g. a decode error; anything escaping this thread would terminate the process
+            error = DomeAPIError(-1, std::string("Market catalog refresh failed: ") + e.what());
+        }
+        lock.lock();
+        if (error && error_callback_) {
+            RefreshErrorCallback callback = error_callback_;
+            lock.unlock();
+            callback(*error);
+            lock.lock();
+        }
+    }
+}
+
+std::shared_ptr<const MarketCatalogSnapshot> MarketCatalog::snapshot() const {
+    return std::atomic_load(&snapshot_);
+}
+
+std::optional<Market> MarketCatalog::find_by_slug(const std::string& market_slug) const {
+    auto current = snapshot();
+    const Market* market = current->by_slug(market_slug);
+    return market ? std::optional<Market>(*market) : std::nullopt;
+}
+
+std::optional<Market> MarketCatalog::find_by_condition_id(const std::string& condition_id) const {
+    auto current = snapshot();
+    const Market* market = current->by_condition_id(condition_id);
+    return market ? std::optional<Market>(*market) : std::nullopt;
+}
+
+std::optional<Market> MarketCatalog::find_by_token_id(const std::string& token_id) const {
+    auto current = snapshot();
+    const Market* market = current->by_token_id(token_id);
+    return market ? std::optional<Market>(*market) : std::nullopt;
+}
+
+std::shared_ptr<const TokenIndex> MarketCatalog::token_index() const {
+    auto current = snapshot();
+    return std::shared_ptr<const TokenIndex>(current, &current->tokens());
+}
+
+}  // namespace dome
@@ -0,0 +1,188 @@
+#include "dome_api_sdk/order_book.hpp"
+
+#include <algorithm>
+
+namespace dome {
+
+// OrderBook
+
+void OrderBook::load(const OrderbookSnapshot& snapshot) {
+    load_side(bids_, snapshot.bids, true);
+    load_side(asks_, snapshot.asks, false);
+    asset_id_ = snapshot.assetId;
+    hash_ = snapshot.hash;
+    timestamp_ = snapshot.timestamp;
+    tick_size_ = snapshot.tickSize;
+}
+
+void OrderBook::load_side(Side& side, const std::vector<OrderbookLevel>& levels, bool descending) {
+    auto better = [descending](const OrderbookLevel& a, const OrderbookLevel& b) {
+        return descending ? a.price > b.price : a.price < b.price;
+    };
+    auto worse = [&better](const OrderbookLevel& a, const OrderbookLevel& b) { return better(b, a); };
+
+    side.levels.assign(levels.begin(), levels.end());
+    auto& out = side.levels;
+
+    // The API returns each side worst-first, so a reverse usually replaces the sort
+    if (std::is_sorted(out.begin(), out.end(), worse)) {
+        std::reverse(out.begin(), out.end());
+    } else if (!std::is_sorted(out.begin(), out.end(), better)) {
+        std::sort(out.begin(), out.end(), better);
+    }
+
+    // Merge duplicate prices and drop empty levels in place
+    size_t write = 0;
+    for (size_t read = 0; read < out.size(); ++read) {
+        if (write > 0 && out[write - 1].price == out[read].price) {
+            out[write - 1].size += out[read].size;
+        } else {
+            out[write++] = out[read];
+        }
+    }
+    out.resize(write);
+    out.erase(std::remove_if(out.begin(), out.end(),
+                             [](const OrderbookLevel& level) { return level.size <= Decimal(); }),
+              out.end());
+
+    update_totals(side, 0);
+}
+
+void OrderBook::update_totals(Side& side, size_t from) {
+    side.cumulative_size.resize(side.levels.size());
+    side.cumulative_notional.resize(side.levels.size());
+    Decimal size = from > 0 ? side.cumulative_size[from - 1] : Decimal();
+    Decimal notional = from > 0 ? side.cumulative_notional[from - 1] : Decimal();
+    for (size_t i = from; i < side.levels.size(); ++i) {
+        size += side.levels[i].size;
+        notional += side.levels[i].price * side.levels[i].size;
+        side.cumulative_size[i] = size;
+        side.cumulative_notional[i] = notional;
+    }
+}
+
+size_t OrderBook::lower_bound(const Side& side, Decimal price, bool descending) {
+    auto it = std::lower_bound(side.levels.begin(), side.levels.end(), price,
+                               [descending](const OrderbookLevel& level, Decimal value) {
+                                   return descending ? level.price > value : level.price < value;
+                               });
+    return static_cast<size_t>(it - side.levels.begin());
+}
+
+void OrderBook::set_level(BookSide book_side, Decimal price, Decimal size) {
+    Side& side = side_of(book_side);
+    bool descending = book_side == BookSide::BID;
+    size_t index = lower_bound(side, price, descending);
+    bool exists = index < side.levels.size() && side.levels[index].price == price;
+
+    if (size <= Decimal()) {
+        if (!exists) {
+            return;
+        }
+        side.levels.erase(side.levels.begin() + static_cast<std::ptrdiff_t>(index));
+    } else if (exists) {
+        side.levels[index].size = size;
+    } else {
+        side.levels.insert(side.levels.begin() + static_cast<std::ptrdiff_t>(index), {price, size});
+    }
+    update_totals(side, index);
+}
+
+void OrderBook::clear() {
+    for (Side* side : {&bids_, &asks_}) {
+        side->levels.clear();
+        side->cumulative_size.clear();
+        side->cumulative_notional.clear();
+    }
+    hash_.clear();
+    timestamp_ = 0;
+}
+
+std::optional<OrderbookLevel> OrderBook::best_bid() const {
+    if (bids_.levels.empty()) return std::nullopt;
+    return bids_.levels.front();
+}
+
+std::optional<OrderbookLevel> OrderBook::best_ask() const {
+    if (asks_.levels.empty()) return std::nullopt;
+    return asks_.levels.front();
+}
+
+std::optional<Decimal> OrderBook::mid_price() const {
+    if (bids_.levels.empty() || asks_.levels.empty()) return std::nullopt;
+    return (bids_.levels.front().price + asks_.levels.front().price) / Decimal::from_int(2);
+}
+
+std::optional<Decimal> OrderBook::spread() const {
+    if (bids_.levels.empty() || asks_.levels.empty()) return std::nullopt;
+    return asks_.levels.front().price - bids_.levels.front().price;
+}
+
+Decimal OrderBook::depth_at(BookSide book_side, Decimal price) const {
+    const Side& side = side_of(book_side);
+    size_t index = lower_bound(side, price, book_side == BookSide::BID);
+    if (index < side.levels.size() && side.levels[index].price == price) {
+        return side.levels[index].size;
+    }
+    return Decimal();
+}
+
+Decimal OrderBook::cumulative_depth(BookSide book_side, Decimal limit_price) const {
+    const Side& side = side_of(book_side);
+    size_t count = lower_bound(side, limit_price, book_side == BookSide::BID);
+    if (count < side.levels.size() && side.levels[count].price == limit_price) {
+        ++count;
+    }
+    return count > 0 ? side.cumulative_size[count - 1] : Decimal();
+}
+
+std::optional<Decimal> OrderBook::vwap(BookSide book_side, Decimal size) const {
+    const Side& side = side_of(book_side);
+    if (size <= Decimal() || side.levels.empty() || side.cumulative_size.back() < size) {
+        return std::nullopt;
+    }
+
+    // First level at which the running size covers the request
+    auto it = std::lower_bound(side.cumulative_size.begin(), side.cumulative_size.end(), size);
+    size_t index = static_cast<size_t>(it - side.cumulative_size.begin());
+
+    Decimal filled_before = index > 0 ? side.cumulative_size[index - 1] : Decimal();
+    Decimal notional_before = index > 0 ? side.cumulative_notional[index - 1] : Decimal();
+    Decimal notional = notional_before + (size - filled_before) * side.levels[index].price;
+    return notional / size;
+}
+
+Decimal OrderBook::total_depth(BookSide book_side) const {
+    const Side& side = side_of(book_side);
+    return side.cumulative_size.empty() ? Decimal() : side.cumulative_size.back();
+}
+
+const std::vector<OrderbookLevel>& OrderBook::levels(BookSide book_side) const {
+    return side_of(book_side).levels;
+}
+
+// OrderBookEngine
+
+const OrderBook& OrderBookEngine::ingest(const OrderbookSnapshot& snapshot) {
+    OrderBook& book = books_[snapshot.assetId];
+    if (snapshot.timestamp >= book.timestamp()) {
+        book.load(snapshot);
+    }
+    return book;
+}
+
+void OrderBookEngine::ingest(const OrderbooksResponse& response, const BookCallback& on_update) {
+    for (const auto& snapshot : response.snapshots) {
+        const OrderBook& book = ingest(snapshot);
+        if (on_update) {
+            on_update(book);
+        }
+    }
+}
+
+const OrderBook* OrderBookEngine::book(const std::string& asset_id) const {
+    auto it = books_.find(asset_id);
+    return it == books_.end() ? nullptr : &it->second;
+}
+
+}  // namespace dome
@@ -0,0 +1,169 @@
+#include "dome_api_sdk/orderbook_delta.hpp"
+
+#include <algorithm>
+
+namespace dome {
+
+// Sort ascending by price, merge duplicate prices and drop empty levels
+static void normalize_levels(const std::vector<OrderbookLevel>& levels, std::vector<OrderbookLevel>& out) {
+    auto by_price = [](const OrderbookLevel& a, const OrderbookLevel& b) { return a.price < b.price; };
+
+    out.assign(levels.begin(), levels.end());
+    if (!std::is_sorted(out.begin(), out.end(), by_price)) {
+        std::sort(out.begin(), out.end(), by_price);
+    }
+
+    size_t write = 0;
+    for (size_t read = 0; read < out.size(); ++read) {
+        if (write > 0 && out[write - 1].price == out[read].price) {
+            out[write - 1].size += out[read].size;
+        } else {
+            out[write++] = out[read];
+        }
+    }
+    out.resize(write);
+    out.erase(std::remove_if(out.begin(), out.end(),
+                             [](const OrderbookLevel& level) { return level.size <= Decimal(); }),
+              out.end());
+}
+
+// Emit the level changes that turn before into after (both ascending)
+static void diff_levels(const std::vector<OrderbookLevel>& before,
+                        const std::vector<OrderbookLevel>& after,
+                        BookSide side,
+                        std::vector<OrderbookLevelChange>& changes) {
+    size_t i = 0;
+    size_t j = 0;
+    while (i < before.size() || j < after.size()) {
+        if (j == after.size() || (i < before.size() && before[i].price < after[j].price)) {
+            changes.push_back({side, before[i].price, Decimal()});
+            ++i;
+        } else if (i == before.size() || after[j].price < before[i].price) {
+            changes.push_back({side, after[j].price, after[j].size});
+            ++j;
+        } else {
+            if (before[i].size != after[j].size) {
+                changes.push_back({side, after[j].price, after[j].size});
+            }
+            ++i;
+            ++j;
+        }
+    }
+}
+
+// Apply ascending changes for one side to ascending levels
+static void apply_changes(std::vector<OrderbookLevel>& levels,
+                          std::vector<OrderbookLevelChange>::const_iterator first,
+                          std::vector<OrderbookLevelChange>::const_iterator last,
+                          std::vector<OrderbookLevel>& scratch) {
+    scratch.clear();
+    scratch.reserve(levels.size() + static_cast<size_t>(last - first));
+    size_t i = 0;
+    while (i < levels.size() || first != last) {
+        if (first == last || (i < levels.size() && levels[i].price < first->price)) {
+            scratch.push_back(levels[i++]);
+            continue;
+        }
+        if (i < levels.size() && levels[i].price == first->price) {
+            ++i;
+        }
+        if (first->size > Decimal()) {
+            scratch.push_back({first->price, first->size});
+        }
+        ++first;
+    }
+    levels.swap(scratch);
+}
+
+// OrderbookDeltaEncoder
+
+std::optional<OrderbookDelta> OrderbookDeltaEncoder::encode(const OrderbookSnapshot& snapshot) {
+    ++stats_.snapshots;
+    stats_.levels_in += snapshot.bids.size() + snapshot.asks.size();
+
+    auto [it, inserted] = previous_.try_emplace(snapshot.assetId);
+    State& state = it->second;
+
+    if (!inserted && !snapshot.hash.empty() && snapshot.hash == state.hash) {
+        ++stats_.skipped;
+        return std::nullopt;
+    }
+
+    OrderbookDelta delta;
+    delta.asset_id = snapshot.assetId;
+    delta.timestamp = snapshot.timestamp;
+    delta.indexed_at = snapshot.indexedAt;
+    delta.hash = snapshot.hash;
+
+    normalize_levels(snapshot.bids, scratch_);
+    diff_levels(state.bids, scratch_, BookSide::BID, delta.changes);
+    state.bids.swap(scratch_);
+
+    normalize_levels(snapshot.asks, scratch_);
+    diff_levels(state.asks, scratch_, BookSide::ASK, delta.changes);
+    state.asks.swap(scratch_);
+
+    if (inserted || snapshot.tickSize != state.tick_size) {
+        delta.tick_size = snapshot.tickSize;
+    }
+    if (inserted || snapshot.minOrderSize != state.min_order_size) {
+        delta.min_order_size = snapshot.minOrderSize;
+    }
+    if (inserted || snapshot.negRisk != state.neg_risk) {
+        delta.neg_risk = snapshot.negRisk;
+    }
+    if (inserted || snapshot.market != state.market) {
+        delta.market = snapshot.market;
+    }
+
+    state.hash = snapshot.hash;
+    state.tick_size = snapshot.tickSize;
+    state.min_order_size = snapshot.minOrderSize;
+    state.neg_risk = snapshot.negRisk;
+    state.market = snapshot.market;
+
+    stats_.levels_out += delta.changes.size();
+    return delta;
+}
+
+void OrderbookDeltaEncoder::encode(const OrderbooksResponse& response, const DeltaCallback& on_delta) {
+    for (const auto& snapshot : response.snapshots) {
+        auto delta = encode(snapshot);
+        if (delta.has_value()) {
+            on_delta(*delta);
+        }
+    }
+}
+
+void OrderbookDeltaEncoder::reset() {
+    previous_.clear();
+    stats_ = OrderbookDeltaStats();
+}
+
+// OrderbookDeltaDecoder
+
+const OrderbookSnapshot& OrderbookDeltaDecoder::decode(const OrderbookDelta& delta) {
+    OrderbookSnapshot& snapshot = books_[delta.asset_id];
+    snapshot.assetId = delta.asset_id;
+    snapshot.timestamp = delta.timestamp;
+    snapshot.indexedAt = delta.indexed_at;
+    snapshot.hash = delta.hash;
+    if (delta.tick_size.has_value()) snapshot.tickSize = *delta.tick_size;
+    if (delta.min_order_size.has_value()) snapshot.minOrderSize = *delta.min_order_size;
+    if (delta.neg_risk.has_value()) snapshot.negRisk = *delta.neg_risk;
+    if (delta.market.has_value()) snapshot.market = *delta.market;
+
+    // Changes are bids then asks
+    auto asks_begin = std::find_if(delta.changes.begin(), delta.changes.end(),
+                                   [](const OrderbookLevelChange& c) { return c.side == BookSide::ASK; });
+    apply_changes(snapshot.bids, delta.changes.begin(), asks_begin, scratch_);
+    apply_changes(snapshot.asks, asks_begin, delta.changes.end(), scratch_);
+    return snapshot;
+}
+
+const OrderbookSnapshot* OrderbookDeltaDecoder::snapshot(const std::string& asset_id) const {
+    auto it = books_.find(asset_id);
+    return it == books_.end() ? nullptr : &it->second;
+}
+
+}  // namespace dome
@@ -0,0 +1,298 @@
+#include "dome_api_sdk/pnl_engine.hpp"
+
+#include <algorithm>
+
+namespace dome {
+
+// Apply records oldest first; pages arrive newest first
+template<typename Records, typename Apply>
+static void apply_in_time_order(const Records& records, Apply apply) {
+    std::vector<const typename Records::value_type*> ordered;
+    ordered.reserve(records.size());
+    for (const auto& record : records) {
+        ordered.push_back(&record);
+    }
+    std::stable_sort(ordered.begin(), ordered.end(),
+                     [](const auto* a, const auto* b) { return a->timestamp < b->timestamp; });
+    for (const auto* record : ordered) {
+        apply(*record);
+    }
+}
+
+void PnLEngine::track(const std::string& wallet_address) {
+    Address20 wallet = Address20::parse(wallet_address);
+    std::lock_guard<std::mutex> lock(mutex_);
+    tracked_.insert(wallet);
+}
+
+void PnLEngine::untrack(const std::string& wallet_address) {
+    Address20 wallet;
+    if (!Address20::try_parse(wallet_address, wallet)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    tracked_.erase(wallet);
+    wallets_.erase(wallet);
+}
+
+bool PnLEngine::is_tracked(const Address20& wallet) const {
+    return tracked_.empty() || tracked_.count(wallet) > 0;
+}
+
+Position& PnLEngine::position_for(const Address20& wallet, const Uint256& token, const std::string& token_id,
+                                  const std::string& condition_id) {
+    auto [it, inserted] = wallets_[wallet].positions.try_emplace(token);
+    Position& position = it->second;
+    if (inserted) {
+        position.token_id = token_id;
+        position.condition_id = condition_id;
+    }
+    return position;
+}
+
+void PnLEngine::acquire(Position& position, Decimal shares, Decimal price) {
+    position.shares += shares;
+    position.cost_basis += shares * price;
+}
+
+void PnLEngine::dispose(Position& position, Decimal shares, Decimal price) {
+    Decimal closing = std::min(shares, position.shares);
+    if (closing > Decimal()) {
+        Decimal cost = position.shares == closing ? position.cost_basis
+                                                  : position.average_cost() * closing;
+        position.realized_pnl += closing * price - cost;
+        position.cost_basis -= cost;
+        position.shares -= closing;
+    }
+    if (shares > closing) {
+        position.unmatched_shares += shares - closing;
+    }
+}
+
+void PnLEngine::on_order(const Order& order) {
+    Address20 wallet;
+    Uint256 token;
+    if (order.shares_normalized <= Decimal() ||
+        !Address20::try_parse(order.user, wallet) || !Uint256::try_parse(order.token_id.str(), token)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    marks_[token] = order.price;
+    if (!is_tracked(wallet)) {
+        return;
+    }
+
+    Position& position = position_for(wallet, token, order.token_id, order.condition_id);
+    if (order.side == "BUY") {
+        acquire(position, order.shares_normalized, order.price);
+    } else if (order.side == "SELL") {
+        dispose(position, order.shares_normalized, order.price);
+    } else {
+        return;
+    }
+    position.last_update = std::max(position.last_update, order.timestamp);
+}
+
+void PnLEngine::on_order_event(const WebSocketOrderEvent& event) {
+    on_order(event.data);
+}
+
+void PnLEngine::set_outcomes(const Market& market) {
+    Hash32 condition;
+    Outcomes outcomes;
+    if (!Hash32::try_parse(market.condition_id, condition) ||
+        !Uint256::try_parse(market.side_a.id, outcomes.tokens[0]) ||
+        !Uint256::try_parse(market.side_b.id, outcomes.tokens[1])) {
+        return;
+    }
+    outcomes.token_ids[0] = market.side_a.id;
+    outcomes.token_ids[1] = market.side_b.id;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    conditions_[outcomes.tokens[0]] = condition;
+    conditions_[outcomes.tokens[1]] = condition;
+    outcomes_[condition] = std::move(outcomes);
+}
+
+void PnLEngine::set_outcomes(const MarketsResponse& markets) {
+    for (const auto& market : markets.markets) {
+        set_outcomes(market);
+    }
+}
+
+// By condition ID, else by the activity's token
+const PnLEngine::Outcomes* PnLEngine::outcomes_for(const std::string& condition_id, const Uint256* token) const {
+    Hash32 condition;
+    if (!Hash32::try_parse(condition_id, condition)) {
+        if (token == nullptr) {
+            return nullptr;
+        }
+        auto known = conditions_.find(*token);
+        if (known == conditions_.end()) {
+            return nullptr;
+        }
+        condition = known->second;
+    }
+    auto it = outcomes_.find(condition);
+    return it == outcomes_.end() ? nullptr : &it->second;
+}
+
+void PnLEngine::apply_pair(const Address20& wallet, const Outcomes& outcomes, const Activity& activity) {
+    // Split the $1 per pair in proportion to the marks so the two prices sum to 1
+    const Decimal one = Decimal::from_int(1);
+    Decimal prices[2] = {one / Decimal::from_int(2), one / Decimal::from_int(2)};
+    auto mark_a = marks_.find(outcomes.tokens[0]);
+    auto mark_b = marks_.find(outcomes.tokens[1]);
+    if (mark_a != marks_.end() && mark_b != marks_.end() && mark_a->second + mark_b->second > Decimal()) {
+        prices[0] = mark_a->second / (mark_a->second + mark_b->second);
+        prices[1] = one - prices[0];
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        Position& position = position_for(wallet, outcomes.tokens[i], outcomes.token_ids[i], activity.condition_id);
+        if (activity.side == "SPLIT") {
+            acquire(position, activity.shares_normalized, prices[i]);
+        } else {
+            dispose(position, activity.shares_normalized, prices[i]);
+        }
+        position.last_update = std::max(position.last_update, activity.timestamp);
+    }
+}
+
+void PnLEngine::on_activity(const Activity& activity) {
+    Address20 wallet;
+    if (activity.shares_normalized <= Decimal() || !Address20::try_parse(activity.user, wallet)) {
+        return;
+    }
+    Uint256 token;
+    bool has_token = Uint256::try_parse(activity.token_id.str(), token);
+    bool pair = activity.side == "SPLIT" || activity.side == "MERGE";
+    if (!pair && (activity.side != "REDEEM" || !has_token)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!is_tracked(wallet)) {
+        return;
+    }
+
+    if (pair) {
+        const Outcomes* outcomes = outcomes_for(activity.condition_id, has_token ? &token : nullptr);
+        if (outcomes != nullptr) {
+            apply_pair(wallet, *outcomes, activity);
+        }
+        return;
+    }
+
+    Position& position = position_for(wallet, token, activity.token_id, activity.condition_id);
+    dispose(position, activity.shares_normalized, activity.price);
+    marks_[token] = activity.price;
+    position.last_update = std::max(position.last_update, activity.timestamp);
+}
+
+void PnLEngine::seed(const OrdersResponse& orders) {
+    apply_in_time_order(orders.orders, [this](const Order& order) { on_order(order); });
+}
+
+void PnLEngine::seed(const ActivityResponse& activity) {
+    apply_in_time_order(activity.activities, [this](const Activity& record) { on_activity(record); });
+}
+
+void PnLEngine::mark(const std::string& token_id, Decimal price) {
+    Uint256 token;
+    if (!Uint256::try_parse(token_id, token)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    marks_[token] = price;
+}
+
+Position PnLEngine::with_mark(const Uint256& token, const Position& position) const {
+    Position result = position;
+    auto mark = marks_.find(token);
+    if (mark != marks_.end()) {
+        result.mark_price = mark->second;
+    }
+    return result;
+}
+
+std::optional<Position> PnLEngine::position(const std::string& wallet_address,
+                                            const std::string& token_id) const {
+    Address20 address;
+    Uint256 token;
+    if (!Address20::try_parse(wallet_address, address) || !Uint256::try_parse(token_id, token)) {
+        return std::nullopt;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto wallet = wallets_.find(address);
+    if (wallet == wallets_.end()) {
+        return std::nullopt;
+    }
+    auto it = wallet->second.positions.find(token);
+    if (it == wallet->second.positions.end()) {
+        return std::nullopt;
+    }
+    return with_mark(token, it->second);
+}
+
+std::vector<Position> PnLEngine::positions(const std::string& wallet_address) const {
+    std::vector<Position> result;
+    Address20 address;
+    if (!Address20::try_parse(wallet_address, address)) {
+        return result;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto wallet = wallets_.find(address);
+    if (wallet == wallets_.end()) {
+        return result;
+    }
+    result.reserve(wallet->second.positions.size());
+    for (const auto& entry : wallet->second.positions) {
+        result.push_back(with_mark(entry.first, entry.second));
+    }
+    return result;
+}
+
+WalletPnL PnLEngine::wallet_pnl(const std::string& wallet_address) const {
+    WalletPnL totals;
+    Address20 address;
+    if (!Address20::try_parse(wallet_address, address)) {
+        totals.wallet_address = wallet_address;
+        return totals;
+    }
+    totals.wallet_address = address.to_string();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto wallet = wallets_.find(address);
+    if (wallet == wallets_.end()) {
+        return totals;
+    }
+    for (const auto& entry : wallet->second.positions) {
+        Position position = with_mark(entry.first, entry.second);
+        totals.realized_pnl += position.realized_pnl;
+        totals.unrealized_pnl += position.unrealized_pnl();
+        totals.cost_basis += position.cost_basis;
+        totals.market_value += position.market_value();
+        if (position.shares > Decimal()) {
+            ++totals.open_positions;
+        }
+    }
+    return totals;
+}
+
+std::vector<std::string> PnLEngine::wallets() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> result;
+    result.reserve(wallets_.size());
+    for (const auto& entry : wallets_) {
+        result.push_back(entry.first.to_string());
+    }
+    return result;
+}
+
+void PnLEngine::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    wallets_.clear();
+    marks_.clear();
+}
+
+}  // namespace dome
@@ -0,0 +1,328 @@
+#include "dome_api_sdk/request_scheduler.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace dome {
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr size_t PRIORITY_COUNT = 3;
+
+static size_t priority_index(RequestPriority priority) {
+    return static_cast<size_t>(priority);
+}
+
+// Per-sample growth of the latency baseline, so it follows a lasting slowdown
+// after several hundred requests instead of treating it as congestion forever
+static constexpr double BASELINE_DRIFT = 1.002;
+
+DomeAPIError deadline_exceeded_error() {
+    return DomeAPIError(-1, "Deadline exceeded");
+}
+
+DomeAPIError request_cancelled_error() {
+    return DomeAPIError(-1, "Request cancelled");
+}
+
+struct RequestScheduler::State : std::enable_shared_from_this<State> {
+    struct Waiting {
+        uint64_t ticket = 0;
+        std::optional<Clock::time_point> deadline;
+        Start start;
+        Expired expired;
+    };
+
+    // Callbacks decided under the lock and run after it is released
+    struct Ready {
+        std::vector<std::pair<Start, Permit>> started;
+        std::vector<Expired> expired;
+
+        void run() {
+            for (auto& [start, permit] : started) {
+                start(std::move(permit));
+            }
+            for (auto& expired_callback : expired) {
+                if (expired_callback) expired_callback();
+            }
+        }
+    };
+
+    SchedulerOptions options;
+    mutable std::mutex mutex;
+    std::deque<Waiting> waiting[PRIORITY_COUNT];
+    size_t in_flight = 0;
+    size_t bulk_in_flight = 0;
+    uint64_t next_ticket = 1;
+
+    // Adaptive limit state
+    double limit = 0;
+    double baseline_ms = 0;  // 0 until the first success
+    Clock::time_point last_decrease;
+
+    size_t max_in_flight() const {
+        return options.adaptive ? static_cast<size_t>(limit) : options.max_in_flight;
+    }
+
+    size_t max_bulk_in_flight() const {
+        if (!options.adaptive) {
+            return options.max_bulk_in_flight;
+        }
+        double share = static_cast<double>(options.max_bulk_in_flight) / options.max_in_flight;
+        return std::max<size_t>(1, static_cast<size_t>(limit * share));
+    }
+
+    bool has_slot(size_t priority) const {
+        if (in_flight >= max_in_flight()) {
+            return false;
+        }
+        return priority != priority_index(RequestPriority::BULK) || bulk_in_flight < max_bulk_in_flight();
+    }
+
+    // AIMD step for one finished request; requires mutex
+    void adapt(RequestOutcome outcome, Clock::time_point granted) {
+        if (!options.adaptive || outcome == RequestOutcome::IGNORED) {
+            return;
+        }
+        auto now = Clock::now();
+        double latency_ms = std::chrono::duration<double, std::milli>(now - granted).count();
+        bool congested = outcome == RequestOutcome::OVERLOADED;
+        if (outcome == RequestOutcome::SUCCESS) {
+            baseline_ms = baseline_ms == 0 ? latency_ms : std::min(latency_ms, baseline_ms * BASELINE_DRIFT);
+            congested = latency_ms > baseline_ms * options.latency_tolerance;
+        }
+
+        double ceiling = static_cast<double>(options.max_in_flight);
+        double floor = static_cast<double>(options.min_in_flight);
+        if (congested) {
+            // Requests granted before the last cut saw the old limit; don't cut again for them
+            if (granted >= last_decrease) {
+                limit = std::max(floor, limit * options.backoff);
+                last_decrease = now;
+            }
+        } else if (in_flight >= max_in_flight()) {
+            // Only grow a limit that is actually the bottleneck
+            limit = std::min(ceiling, limit + 1.0 / limit);
+        }
+    }
+
+    // Start waiting requests in priority order while slots are free; requires mutex
+    void dispatch(Ready& ready) {
+        auto now = Clock::now();
+        for (size_t priority = 0; priority < PRIORITY_COUNT; ++priority) {
+            auto& queue = waiting[priority];
+            while (!queue.empty()) {
+                Waiting& front = queue.front();
+                if (front.deadline && *front.deadline <= now) {
+                    ready.expired.push_back(std::move(front.expired));
+                    queue.pop_front();
+                    continue;
+                }
+                if (!has_slot(priority)) {
+                    break;
+                }
+                ++in_flight;
+                if (priority == priority_index(RequestPriority::BULK)) {
+                    ++bulk_in_flight;
+                }
+                ready.started.emplace_back(std::move(front.start),
+                                           Permit(shared_from_this(), static_cast<RequestPriority>(priority)));
+                queue.pop_front();
+            }
+            if (in_flight >= max_in_flight()) {
+                return;
+            }
+        }
+    }
+
+    void release(RequestPriority priority) {
+        Ready ready;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --in_flight;
+            if (priority == RequestPriority::BULK) {
+                --bulk_in_flight;
+            }
+            dispatch(ready);
+        }
+        ready.run();
+    }
+};
+
+// Permit
+
+RequestScheduler::Permit::Permit(std::shared_ptr<State> state, RequestPriority priority)
+    : state_(std::move(state)), priority_(priority), granted_(Clock::now()) {}
+
+RequestScheduler::Permit::Permit(Permit&& other) noexcept
+    : state_(std::move(other.state_)), priority_(other.priority_), granted_(other.granted_) {}
+
+RequestScheduler::Permit& RequestScheduler::Permit::operator=(Permit&& other) noexcept {
+    if (this != &other) {
+        release();
+        state_ = std::move(other.state_);
+        priority_ = other.priority_;
+        granted_ = other.granted_;
+    }
+    return *this;
+}
+
+RequestScheduler::Permit::~Permit() {
+    release();
+}
+
+void RequestScheduler::Permit::report(RequestOutcome outcome) {
+    if (state_) {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->adapt(outcome, granted_);
+    }
+}
+
+void RequestScheduler::Permit::release() {
+    if (state_) {
+        std::shared_ptr<State> state = std::move(state_);
+        state->release(priority_);
+    }
+}
+
+// RequestScheduler
+
+RequestScheduler::RequestScheduler(SchedulerOptions options) : options_(options), state_(std::make_shared<State>()) {
+    options_.max_in_flight = std::max<size_t>(1, options_.max_in_flight);
+    options_.max_bulk_in_flight = std::clamp<size_t>(options_.max_bulk_in_flight, 1, options_.max_in_flight);
+    options_.min_in_flight = std::clamp<size_t>(options_.min_in_flight, 1, options_.max_in_flight);
+    options_.latency_tolerance = std::max(1.0, options_.latency_tolerance);
+    options_.backoff = std::clamp(options_.backoff, 0.1, 1.0);
+    state_->options = options_;
+    state_->limit = static_cast<double>(options_.max_in_flight);
+}
+
+RequestScheduler::~RequestScheduler() = default;
+
+uint64_t RequestScheduler::enqueue(const RequestConfig& request, Start start, Expired expired) {
+    State::Ready ready;
+    uint64_t ticket = 0;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        ticket = state_->next_ticket++;
+        state_->waiting[priority_index(request.priority)].push_back(
+            {ticket, request.deadline, std::move(start), std::move(expired)});
+        state_->dispatch(ready);
+    }
+    ready.run();
+    return ticket;
+}
+
+RequestScheduler::Permit RequestScheduler::acquire(const RequestConfig& request) {
+    if (request.cancellation.cancelled()) {
+        throw request_cancelled_error();
+    }
+    if (request.deadline && *request.deadline <= Clock::now()) {
+        throw deadline_exceeded_error();
+    }
+
+    struct Waiter {
+        std::mutex mutex;
+        std::condition_variable cv;
+        Permit permit;
+        bool done = false;
+        bool cancelled = false;
+    };
+    auto waiter = std::make_shared<Waiter>();
+    auto finish = [waiter](Permit permit) {
+        {
+            std::lock_guard<std::mutex> lock(waiter->mutex);
+            waiter->permit = std::move(permit);
+            waiter->done = true;
+        }
+        waiter->cv.notify_one();
+    };
+    uint64_t ticket = enqueue(request, finish, [finish] { finish(Permit()); });
+    CancellationCallback on_cancel(request.cancellation, [waiter] {
+        {
+            std::lock_guard<std::mutex> lock(waiter->mutex);
+            waiter->cancelled = true;
+        }
+        waiter->cv.notify_one();
+    });
+
+    std::unique_lock<std::mutex> lock(waiter->mutex);
+    auto is_done = [&] { return waiter->done || waiter->cancelled; };
+    bool in_time = true;
+    if (!request.deadline) {
+        waiter->cv.wait(lock, is_done);
+    } else {
+        in_time = waiter->cv.wait_until(lock, *request.deadline, is_done);
+    }
+    if (!waiter->done) {
+        lock.unlock();
+        if (cancel(ticket)) {
+            throw in_time ? request_cancelled_error() : deadline_exceeded_error();
+        }
+        // Started or shed concurrently with the timeout or cancellation
+        lock.lock();
+        waiter->cv.wait(lock, [&] { return waiter->done; });
+    }
+    if (waiter->cancelled) {
+        throw request_cancelled_error();
+    }
+    if (!waiter->permit) {
+        throw deadline_exceeded_error();
+    }
+    return std::move(waiter->permit);
+}
+
+bool RequestScheduler::cancel(uint64_t ticket) {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    for (auto& queue : state_->waiting) {
+        auto it = std::find_if(queue.begin(), queue.end(),
+                               [ticket](const State::Waiting& waiting) { return waiting.ticket == ticket; });
+        if (it != queue.end()) {
+            queue.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+void RequestScheduler::expire() {
+    State::Ready ready;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        auto now = Clock::now();
+        for (auto& queue : state_->waiting) {
+            auto expired = std::stable_partition(queue.begin(), queue.end(), [now](const State::Waiting& waiting) {
+                return !waiting.deadline || *waiting.deadline > now;
+            });
+            for (auto it = expired; it != queue.end(); ++it) {
+                ready.expired.push_back(std::move(it->expired));
+            }
+            queue.erase(expired, queue.end());
+        }
+    }
+    ready.run();
+}
+
+size_t RequestScheduler::in_flight() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->in_flight;
+}
+
+size_t RequestScheduler::limit() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->max_in_flight();
+}
+
+size_t RequestScheduler::queued() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    size_t count = 0;
+    for (const auto& queue : state_->waiting) {
+        count += queue.size();
+    }
+    return count;
+}
+
+}  // namespace dome
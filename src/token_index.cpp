@@ -0,0 +1,75 @@
+#include "dome_api_sdk/token_index.hpp"
+
+#include <functional>
+
+namespace dome {
+
+TokenIndex::TokenIndex(std::vector<Market> markets)
+    : markets_(std::move(markets)) {
+    build();
+}
+
+TokenIndex::TokenIndex(const MarketsResponse& response)
+    : markets_(response.markets) {
+    build();
+}
+
+const MarketSide& TokenIndex::side_of(uint32_t entry) const {
+    const Market& market = markets_[entry >> 1];
+    return (entry & 1) ? market.side_b : market.side_a;
+}
+
+void TokenIndex::build() {
+    size_t capacity = 16;
+    while (capacity < markets_.size() * 4) {
+        capacity <<= 1;
+    }
+    slots_.assign(capacity, Slot());
+    mask_ = capacity - 1;
+    tokens_ = 0;
+
+    for (size_t i = 0; i < markets_.size(); ++i) {
+        uint32_t market = static_cast<uint32_t>(i) << 1;
+        if (!markets_[i].side_a.id.empty()) insert(markets_[i].side_a.id, market);
+        if (!markets_[i].side_b.id.empty()) insert(markets_[i].side_b.id, market | 1);
+    }
+}
+
+void TokenIndex::insert(std::string_view token_id, uint32_t entry) {
+    size_t hash = std::hash<std::string_view>()(token_id);
+    uint32_t tag = static_cast<uint32_t>(hash >> 32) ^ static_cast<uint32_t>(hash);
+    for (size_t position = hash & mask_;; position = (position + 1) & mask_) {
+        Slot& slot = slots_[position];
+        if (slot.entry == kEmpty) {
+            slot = {tag, entry};
+            ++tokens_;
+            return;
+        }
+        if (slot.tag == tag && side_of(slot.entry).id == token_id) {
+            slot.entry = entry;  // Later listings of a token win
+            return;
+        }
+    }
+}
+
+TokenMatch TokenIndex::find(std::string_view token_id) const {
+    if (slots_.empty()) {
+        return {};
+    }
+    size_t hash = std::hash<std::string_view>()(token_id);
+    uint32_t tag = static_cast<uint32_t>(hash >> 32) ^ static_cast<uint32_t>(hash);
+    for (size_t position = hash & mask_;; position = (position + 1) & mask_) {
+        const Slot& slot = slots_[position];
+        if (slot.entry == kEmpty) {
+            return {};
+        }
+        if (slot.tag == tag) {
+            const MarketSide& side = side_of(slot.entry);
+            if (side.id == token_id) {
+                return {&markets_[slot.entry >> 1], &side, (slot.entry & 1) != 0};
+            }
+        }
+    }
+}
+
+}  // namespace dome
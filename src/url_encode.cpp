@@ -0,0 +1,135 @@
+#include "dome_api_sdk/url_encode.hpp"
+
+#include <algorithm>
+#include <array>
+
+#if defined(__SSE2__) && !defined(DOME_FORCE_SCALAR)
+#include <emmintrin.h>
+#endif
+
+namespace dome {
+
+static constexpr std::array<bool, 256> make_unreserved_table() {
+    std::array<bool, 256> table{};
+    for (int c = 'a'; c <= 'z'; ++c) table[c] = true;
+    for (int c = 'A'; c <= 'Z'; ++c) table[c] = true;
+    for (int c = '0'; c <= '9'; ++c) table[c] = true;
+    table['-'] = table['.'] = table['_'] = table['~'] = true;
+    return table;
+}
+
+static constexpr std::array<bool, 256> kUnreserved = make_unreserved_table();
+
+#if defined(__SSE2__) && !defined(DOME_FORCE_SCALAR)
+// Bit i set when byte i of the block is unreserved
+static inline int unreserved_mask(__m128i chars) {
+    auto in_range = [](__m128i c, char low, char high) {
+        return _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(static_cast<char>(low - 1))),
+                             _mm_cmplt_epi8(c, _mm_set1_epi8(static_cast<char>(high + 1))));
+    };
+    __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+    __m128i ok = _mm_or_si128(in_range(lower, 'a', 'z'), in_range(chars, '0', '9'));
+    ok = _mm_or_si128(ok, _mm_cmpeq_epi8(chars, _mm_set1_epi8('-')));
+    ok = _mm_or_si128(ok, _mm_cmpeq_epi8(chars, _mm_set1_epi8('.')));
+    ok = _mm_or_si128(ok, _mm_cmpeq_epi8(chars, _mm_set1_epi8('_')));
+    ok = _mm_or_si128(ok, _mm_cmpeq_epi8(chars, _mm_set1_epi8('~')));
+    return _mm_movemask_epi8(ok);
+}
+#endif
+
+void append_url_encoded(std::string& out, std::string_view value) {
+    static const char hex[] = "0123456789ABCDEF";
+
+    // Worst case every byte becomes %XX
+    size_t start = out.size();
+    out.resize(start + value.size() * 3);
+    char* write = &out[start];
+    const char* read = value.data();
+    const char* end = read + value.size();
+
+    while (read < end) {
+#if defined(__SSE2__) && !defined(DOME_FORCE_SCALAR)
+        // Copy whole runs of unreserved characters 16 bytes at a time
+        if (end - read >= 16) {
+            __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(read));
+            int mask = unreserved_mask(chars);
+            if (mask == 0xFFFF) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(write), chars);
+                read += 16;
+                write += 16;
+                continue;
+            }
+            // Copy the unreserved prefix, then fall through for the reserved byte
+            int run = __builtin_ctz(~mask);
+            for (int i = 0; i < run; ++i) {
+                *write++ = *read++;
+            }
+        }
+#endif
+        unsigned char c = static_cast<unsigned char>(*read++);
+        if (kUnreserved[c]) {
+            *write++ = static_cast<char>(c);
+        } else {
+            write[0] = '%';
+            write[1] = hex[c >> 4];
+            write[2] = hex[c & 0x0F];
+            write += 3;
+        }
+    }
+    out.resize(static_cast<size_t>(write - out.data()));
+}
+
+std::string url_encode(std::string_view value) {
+    std::string out;
+    append_url_encoded(out, value);
+    return out;
+}
+
+// QueryBuilder
+
+QueryBuilder::QueryBuilder(std::string_view base, size_t reserve) {
+    buffer_.reserve(std::max(reserve, base.size()));
+    reset(base);
+}
+
+QueryBuilder& QueryBuilder::reset(std::string_view base) {
+    buffer_.assign(base.data(), base.size());
+    has_query_ = buffer_.find('?') != std::string::npos;
+    return *this;
+}
+
+QueryBuilder& QueryBuilder::append_path(std::string_view path) {
+    buffer_.append(path.data(), path.size());
+    has_query_ = has_query_ || path.find('?') != std::string_view::npos;
+    return *this;
+}
+
+void QueryBuilder::separator() {
+    buffer_.push_back(has_query_ ? '&' : '?');
+    has_query_ = true;
+}
+
+QueryBuilder& QueryBuilder::add(std::string_view key, std::string_view value) {
+    separator();
+    append_url_encoded(buffer_, key);
+    buffer_.push_back('=');
+    append_url_encoded(buffer_, value);
+    return *this;
+}
+
+QueryBuilder& QueryBuilder::add(std::string_view key, int64_t value) {
+    separator();
+    append_url_encoded(buffer_, key);
+    buffer_.push_back('=');
+    buffer_ += std::to_string(value);
+    return *this;
+}
+
+QueryBuilder& QueryBuilder::add_all(const std::map<std::string, std::string>& params) {
+    for (const auto& [key, value] : params) {
+        add(key, value);
+    }
+    return *this;
+}
+
+}  // namespace dome
@@ -0,0 +1,628 @@
+// Checks the hand-vectorized and wide-integer kernels of identifiers.cpp,
+// url_encode.cpp and decimal.cpp against straightforward reference versions.
+// CMake builds this file twice: simd_paths_test against the library as shipped,
+// and simd_paths_test_scalar with DOME_FORCE_SCALAR, which compiles the portable
+// fallbacks instead, so both paths are held to the same references.
+
+#include "dome_api_sdk/decimal.hpp"
+#include "dome_api_sdk/identifiers.hpp"
+#include "dome_api_sdk/url_encode.hpp"
+#include "dome_api_sdk/wide_int.hpp"
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace dome;
+
+static size_t checks = 0;
+static size_t failures = 0;
+
+#define CHECK(condition, context)                                                        \
+    do {                                                                                 \
+        ++checks;                                                                        \
+        if (!(condition) && ++failures <= 20) {                                          \
+            std::ostringstream message;                                                  \
+            message << context;                                                          \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " #condition " failed for "  \
+                      << message.str() << "\n";                                          \
+        }                                                                                \
+    } while (0)
+
+static std::mt19937_64 rng(20240611);
+
+static uint64_t random_below(uint64_t bound) {
+    return std::uniform_int_distribution<uint64_t>(0, bound - 1)(rng);
+}
+
+// Printable form of test input that may hold control or high bytes
+static std::string escaped(std::string_view text) {
+    static const char hex[] = "0123456789abcdef";
+    std::string out = "\"";
+    for (unsigned char c : text) {
+        if (c >= 0x20 && c < 0x7F && c != '\\') {
+            out += static_cast<char>(c);
+        } else {
+            out += "\\x";
+            out += hex[c >> 4];
+            out += hex[c & 0x0F];
+        }
+    }
+    return out + "\"";
+}
+
+// Hex
+
+static int reference_hex_value(unsigned char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static bool reference_decode_hex(std::string_view text, std::vector<uint8_t>& out, size_t size) {
+    if (text.size() >= 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+        text.remove_prefix(2);
+    }
+    if (text.size() != size * 2) {
+        return false;
+    }
+    out.assign(size, 0);
+    for (size_t i = 0; i < size; ++i) {
+        int high = reference_hex_value(static_cast<unsigned char>(text[i * 2]));
+        int low = reference_hex_value(static_cast<unsigned char>(text[i * 2 + 1]));
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        out[i] = static_cast<uint8_t>((high << 4) | low);
+    }
+    return true;
+}
+
+// Hex digits for bytes, each letter in a randomly chosen case
+static std::string mixed_case_hex(const std::vector<uint8_t>& bytes, std::string& lowercase) {
+    static const char lower[] = "0123456789abcdef";
+    static const char upper[] = "0123456789ABCDEF";
+    std::string text;
+    lowercase.clear();
+    for (uint8_t byte : bytes) {
+        for (int nibble : {byte >> 4, byte & 0x0F}) {
+            text += (random_below(2) ? upper : lower)[nibble];
+            lowercase += lower[nibble];
+        }
+    }
+    return text;
+}
+
+static void test_decode_hex() {
+    // Sizes around the 16-byte block: tail only, a block plus a tail, whole blocks
+    for (size_t size = 1; size <= 64; ++size) {
+        for (int round = 0; round < 30; ++round) {
+            std::vector<uint8_t> bytes(size);
+            for (auto& byte : bytes) byte = static_cast<uint8_t>(random_below(256));
+            std::string lowercase;
+            std::string text = std::string(round % 3 == 0 ? "" : round % 3 == 1 ? "0x" : "0X") +
+                               mixed_case_hex(bytes, lowercase);
+
+            std::vector<uint8_t> decoded(size);
+            CHECK(decode_hex(text, decoded.data(), size), text);
+            CHECK(decoded == bytes, text);
+            CHECK(encode_hex(decoded.data(), size) == "0x" + lowercase, text);
+
+            // One digit short or long
+            CHECK(!decode_hex(text.substr(0, text.size() - 1), decoded.data(), size), text);
+            CHECK(!decode_hex(text + "0", decoded.data(), size), text);
+        }
+    }
+
+    // Every byte value at every position, which puts non-hex bytes on both sides of
+    // each block edge, including the bytes just outside '0'-'9', 'a'-'f' and 'A'-'F'
+    // and those that only look like letters once the case bit is set
+    for (size_t size : {16, 20, 32, 48}) {
+        std::vector<uint8_t> bytes(size);
+        for (auto& byte : bytes) byte = static_cast<uint8_t>(random_below(256));
+        std::string lowercase;
+        const std::string valid = mixed_case_hex(bytes, lowercase);
+        for (size_t position = 0; position < valid.size(); ++position) {
+            for (int c = 0; c < 256; ++c) {
+                std::string text = valid;
+                text[position] = static_cast<char>(c);
+                std::vector<uint8_t> expected;
+                std::vector<uint8_t> decoded(size);
+                bool ok = reference_decode_hex(text, expected, size);
+                CHECK(decode_hex(text, decoded.data(), size) == ok, escaped(text) << " size " << size);
+                if (ok) {
+                    CHECK(decoded == expected, escaped(text));
+                }
+            }
+        }
+    }
+
+    // Checksummed and lowercase addresses are the same identifier
+    Address20 checksummed = Address20::parse("0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed");
+    CHECK(checksummed == Address20::parse("0x5aaeb6053f3e94c9b9a09f33669435e7ef1beaed"), checksummed);
+    CHECK(checksummed.to_string() == "0x5aaeb6053f3e94c9b9a09f33669435e7ef1beaed", checksummed);
+
+    Hash32 hash;
+    CHECK(!Hash32::try_parse("0x" + std::string(63, 'a') + "g", hash), "trailing g");
+    bool threw = false;
+    try {
+        Hash32::parse("0x" + std::string(31, 'f') + "/" + std::string(32, 'f'));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw, "Hash32::parse with a '/' before the first block edge");
+}
+
+// Uint256
+
+static const std::string kMaxUint256 =
+    "115792089237316195423570985008687907853269984665640564039457584007913129639935";
+
+// Multiply-by-ten over 32-bit limbs, one digit at a time; the ninth limb catches overflow
+static bool reference_parse_uint256(std::string_view text, std::array<uint64_t, 4>& out) {
+    if (text.empty() || text.size() > 78) {
+        return false;
+    }
+    std::array<uint32_t, 9> limbs{};
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        uint64_t carry = static_cast<uint64_t>(c - '0');
+        for (auto& limb : limbs) {
+            uint64_t value = static_cast<uint64_t>(limb) * 10 + carry;
+            limb = static_cast<uint32_t>(value);
+            carry = value >> 32;
+        }
+    }
+    if (limbs[8] != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < 4; ++i) {
+        out[i] = limbs[i * 2] | (static_cast<uint64_t>(limbs[i * 2 + 1]) << 32);
+    }
+    return true;
+}
+
+static std::string strip_leading_zeros(const std::string& digits) {
+    size_t first = digits.find_first_not_of('0');
+    return first == std::string::npos ? "0" : digits.substr(first);
+}
+
+static void check_uint256(const std::string& text) {
+    std::array<uint64_t, 4> expected{};
+    bool ok = reference_parse_uint256(text, expected);
+    Uint256 value;
+    CHECK(Uint256::try_parse(text, value) == ok, escaped(text));
+    if (ok) {
+        CHECK(value.limbs() == expected, text);
+        CHECK(value.to_string() == strip_leading_zeros(text), text);
+    }
+}
+
+static void test_uint256() {
+    // 2^256 - 1 is the largest 78-digit value that fits; everything above overflows
+    Uint256 max = Uint256::parse(kMaxUint256);
+    CHECK(max.limbs() == (std::array<uint64_t, 4>{~0ull, ~0ull, ~0ull, ~0ull}), max);
+    CHECK(max.to_string() == kMaxUint256, max);
+    for (char last = '0'; last <= '9'; ++last) {
+        check_uint256(kMaxUint256.substr(0, 77) + last);
+    }
+    bool overflow = false;
+    try {
+        Uint256::parse(kMaxUint256.substr(0, 77) + "6");  // 2^256
+    } catch (const std::out_of_range&) {
+        overflow = true;
+    }
+    CHECK(overflow, "2^256");
+    check_uint256(std::string(78, '9'));
+    check_uint256("1" + std::string(77, '0'));
+    check_uint256("0");
+    check_uint256(std::string(78, '0'));
+    check_uint256("0" + kMaxUint256.substr(1));
+    Uint256 value;
+    CHECK(!Uint256::try_parse(std::string(79, '0'), value), "79 zeros");
+    CHECK(!Uint256::try_parse("", value), "empty");
+
+    // Every length, so the head and the 8- and 16-digit chunks take every split
+    for (size_t length = 1; length <= 78; ++length) {
+        for (int round = 0; round < 200; ++round) {
+            std::string text;
+            for (size_t i = 0; i < length; ++i) {
+                text += static_cast<char>('0' + random_below(10));
+            }
+            check_uint256(text);
+        }
+    }
+
+    // A non-digit at every position of every chunk layout
+    for (size_t length : {1, 7, 8, 9, 15, 16, 17, 24, 25, 77, 78}) {
+        for (size_t position = 0; position < length; ++position) {
+            for (char bad : std::string("/: a-\x80\xb9", 7) + '\0') {
+                std::string text = kMaxUint256.substr(0, length);
+                text[position] = bad;
+                check_uint256(text);
+                bool invalid = false;
+                try {
+                    Uint256::parse(text);
+                } catch (const std::invalid_argument&) {
+                    invalid = true;
+                }
+                CHECK(invalid, escaped(text));
+            }
+        }
+    }
+}
+
+// URL encoding
+
+static std::string reference_url_encode(std::string_view value) {
+    static const char hex[] = "0123456789ABCDEF";
+    std::string out;
+    for (unsigned char c : value) {
+        bool unreserved = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                          c == '-' || c == '.' || c == '_' || c == '~';
+        if (unreserved) {
+            out += static_cast<char>(c);
+        } else {
+            out += '%';
+            out += hex[c >> 4];
+            out += hex[c & 0x0F];
+        }
+    }
+    return out;
+}
+
+static void test_url_encode() {
+    // Every byte value at every offset of an otherwise unreserved run
+    const std::string run = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-._~";
+    for (size_t length : {1, 15, 16, 17, 31, 32, 33, 48}) {
+        for (size_t position = 0; position < length; ++position) {
+            for (int c = 0; c < 256; ++c) {
+                std::string text = run.substr(0, length);
+                text[position] = static_cast<char>(c);
+                CHECK(url_encode(text) == reference_url_encode(text), escaped(text));
+            }
+        }
+    }
+
+    // Random text, mostly unreserved so whole blocks are copied between escapes
+    const std::string reserved = " !\"#$%&'()*+,/:;<=>?@[\\]^`{|}\x7f\x80\xff";
+    for (size_t length = 0; length <= 100; ++length) {
+        for (int round = 0; round < 50; ++round) {
+            std::string text;
+            for (size_t i = 0; i < length; ++i) {
+                text += random_below(8) == 0 ? reserved[random_below(reserved.size())] : run[random_below(run.size())];
+            }
+            CHECK(url_encode(text) == reference_url_encode(text), escaped(text));
+
+            std::string appended = "prefix=";
+            append_url_encoded(appended, text);
+            CHECK(appended == "prefix=" + reference_url_encode(text), escaped(text));
+        }
+    }
+
+    QueryBuilder url("https://api.domeapi.io/v1");
+    url.append_path("/polymarket/orders").add("market_slug", "will it rain? 100%").add("limit", 100);
+    CHECK(url.str() == "https://api.domeapi.io/v1/polymarket/orders?market_slug=will%20it%20rain%3F%20100%25&limit=100",
+          url.str());
+}
+
+// Decimal
+
+// Exact rounding of the decimal text to 6 fractional digits, half away from zero,
+// done on the digit string
+static bool reference_parse_decimal(std::string_view text, int64_t& units) {
+    size_t i = 0;
+    size_t n = text.size();
+    while (i < n && text[i] == ' ') ++i;
+    while (n > i && text[n - 1] == ' ') --n;
+
+    bool negative = false;
+    if (i < n && (text[i] == '-' || text[i] == '+')) {
+        negative = text[i] == '-';
+        ++i;
+    }
+    std::string digits;
+    long exponent = 0;
+    bool seen_point = false;
+    for (; i < n; ++i) {
+        if (text[i] >= '0' && text[i] <= '9') {
+            digits += text[i];
+            if (seen_point) --exponent;
+        } else if (text[i] == '.' && !seen_point) {
+            seen_point = true;
+        } else {
+            break;
+        }
+    }
+    if (digits.empty()) {
+        return false;
+    }
+    if (i < n && (text[i] == 'e' || text[i] == 'E')) {
+        ++i;
+        bool exponent_negative = false;
+        if (i < n && (text[i] == '-' || text[i] == '+')) {
+            exponent_negative = text[i] == '-';
+            ++i;
+        }
+        long parsed = 0;
+        size_t start = i;
+        for (; i < n && text[i] >= '0' && text[i] <= '9'; ++i) {
+            if (parsed < 1000000) parsed = parsed * 10 + (text[i] - '0');
+        }
+        if (i == start) {
+            return false;
+        }
+        exponent += exponent_negative ? -parsed : parsed;
+    }
+    if (i != n) {
+        return false;
+    }
+
+    digits = strip_leading_zeros(digits);
+    if (digits == "0") {
+        units = 0;
+        return true;
+    }
+    long shift = exponent + Decimal::kScale;
+    std::string whole;
+    char first_dropped = '0';
+    if (shift >= 0) {
+        if (static_cast<long>(digits.size()) + shift > 20) {
+            return false;
+        }
+        whole = digits + std::string(static_cast<size_t>(shift), '0');
+    } else if (static_cast<size_t>(-shift) < digits.size()) {
+        whole = digits.substr(0, digits.size() - static_cast<size_t>(-shift));
+        first_dropped = digits[whole.size()];
+    } else {
+        whole = "0";
+        if (static_cast<size_t>(-shift) == digits.size()) first_dropped = digits[0];
+    }
+    whole = strip_leading_zeros(whole);
+    if (whole.size() > 19) {
+        return false;
+    }
+    uint64_t magnitude = std::stoull(whole) + (first_dropped >= '5' ? 1 : 0);
+    uint64_t limit = static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + (negative ? 1 : 0);
+    if (magnitude > limit) {
+        return false;
+    }
+    units = negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+    return true;
+}
+
+static void check_decimal(const std::string& text) {
+    int64_t expected = 0;
+    bool ok = reference_parse_decimal(text, expected);
+    Decimal value;
+    CHECK(Decimal::try_parse(text, value) == ok, escaped(text));
+    if (ok) {
+        CHECK(value.raw() == expected, escaped(text) << " gave " << value.raw() << ", expected " << expected);
+        CHECK(Decimal::parse(value.to_string()) == value, escaped(text));
+    }
+}
+
+static void check_decimal(const std::string& text, int64_t units) {
+    Decimal value;
+    CHECK(Decimal::try_parse(text, value) && value.raw() == units, escaped(text) << " expected " << units);
+    check_decimal(text);
+}
+
+static void check_invalid_decimal(const std::string& text) {
+    Decimal value;
+    CHECK(!Decimal::try_parse(text, value), escaped(text));
+    check_decimal(text);
+}
+
+static std::string random_digits(size_t count) {
+    // Favor 0, 4, 5 and 9 so rounding lands on and next to the halfway point
+    static const char favored[] = "04590459001234567899";
+    std::string digits;
+    for (size_t i = 0; i < count; ++i) {
+        digits += favored[random_below(sizeof(favored) - 1)];
+    }
+    return digits;
+}
+
+static void test_decimal_parse() {
+    // Rounding at the sixth fractional digit is half away from zero
+    check_decimal("0.0000005", 1);
+    check_decimal("-0.0000005", -1);
+    check_decimal("0.0000004999999999999999999", 0);
+    check_decimal("0.0000015", 2);
+    check_decimal("0.0000025", 3);
+    check_decimal("1.2345675", 1234568);
+    check_decimal("-1.2345665", -1234567);
+    check_decimal("0.5300", 530000);
+    check_decimal("  42  ", 42000000);
+    check_decimal(".5", 500000);
+    check_decimal("5.", 5000000);
+    check_decimal("12345678901234567890e-7", 1234567890123456789);
+    check_decimal("1234567.8901234567890123", 1234567890123);
+
+    // Exponent forms
+    check_decimal("1e-6", 1);
+    check_decimal("5e-7", 1);
+    check_decimal("4.9e-7", 0);
+    check_decimal("1.5E3", 1500000000);
+    check_decimal("+2.5e+2", 250000000);
+    check_decimal("25e-1", 2500000);
+    check_decimal("0.0001e4", 1000000);
+    check_decimal("0e999", 0);
+    check_decimal("1e-999", 0);
+    check_decimal("-0", 0);
+
+    // Range ends
+    check_decimal("9223372036854.775807", std::numeric_limits<int64_t>::max());
+    check_decimal("-9223372036854.775808", std::numeric_limits<int64_t>::min());
+    check_decimal("9223372036854.7758074", std::numeric_limits<int64_t>::max());
+    check_invalid_decimal("9223372036854.7758075");
+    check_invalid_decimal("9223372036854.775808");
+    check_invalid_decimal("1e13");
+    check_invalid_decimal("1e99999");
+
+    check_invalid_decimal("");
+    check_invalid_decimal(".");
+    check_invalid_decimal("1e");
+    check_invalid_decimal("e1");
+    check_invalid_decimal("1e+");
+    check_invalid_decimal("1.2.3");
+    check_invalid_decimal("--1");
+    check_invalid_decimal("0x10");
+    check_invalid_decimal("1 000");
+
+    for (int round = 0; round < 200000; ++round) {
+        std::string text = std::string(random_below(3) == 0 ? (random_below(2) ? "-" : "+") : "");
+        text += random_digits(random_below(16));
+        if (random_below(4) != 0) {
+            text += "." + random_digits(random_below(24));
+        }
+        if (random_below(3) == 0) {
+            text += random_below(2) ? "e" : "E";
+            text += random_below(3) == 0 ? (random_below(2) ? "-" : "+") : "";
+            text += std::to_string(random_below(30));
+        }
+        check_decimal(text);
+    }
+}
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 ReferenceUint128;
+
+// Exact product or quotient in 6-digit fixed point, half away from zero; false on overflow
+static bool reference_multiply(int64_t a, int64_t b, bool divide, int64_t& out) {
+    auto magnitude = [](int64_t value) {
+        return value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    };
+    ReferenceUint128 numerator = static_cast<ReferenceUint128>(magnitude(a)) *
+                                 (divide ? static_cast<uint64_t>(Decimal::kOne) : magnitude(b));
+    ReferenceUint128 divisor = divide ? magnitude(b) : static_cast<uint64_t>(Decimal::kOne);
+    ReferenceUint128 quotient = numerator / divisor;
+    ReferenceUint128 remainder = numerator % divisor;
+    if (remainder >= divisor - remainder) ++quotient;
+
+    bool negative = (a < 0) != (b < 0);
+    ReferenceUint128 limit = static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + (negative ? 1 : 0);
+    if (quotient > limit) {
+        return false;
+    }
+    uint64_t result = static_cast<uint64_t>(quotient);
+    out = negative ? static_cast<int64_t>(0 - result) : static_cast<int64_t>(result);
+    return true;
+}
+
+static int64_t random_units() {
+    // Magnitudes spread across every bit width so products cover the whole 128-bit range
+    int64_t units = static_cast<int64_t>(rng() >> (1 + random_below(63)));
+    return random_below(2) ? -units : units;
+}
+
+static void test_wide_arithmetic() {
+    for (int round = 0; round < 200000; ++round) {
+        uint64_t a = rng() >> random_below(64);
+        uint64_t b = rng() >> random_below(64);
+        uint64_t addend = rng() >> random_below(64);
+        ReferenceUint128 product = static_cast<ReferenceUint128>(a) * b + addend;
+        Uint128 wide = mul_wide(a, b, addend);
+        CHECK(wide.high == static_cast<uint64_t>(product >> 64) && wide.low == static_cast<uint64_t>(product),
+              a << " * " << b << " + " << addend);
+
+        uint64_t divisor = (rng() >> random_below(64)) | 1;
+        Uint128 dividend{wide.high % divisor, wide.low};
+        ReferenceUint128 native = (static_cast<ReferenceUint128>(dividend.high) << 64) | dividend.low;
+        uint64_t remainder = 0;
+        uint64_t quotient = div_wide(dividend, divisor, remainder);
+        CHECK(quotient == static_cast<uint64_t>(native / divisor) && remainder == static_cast<uint64_t>(native % divisor),
+              dividend.high << ":" << dividend.low << " / " << divisor);
+
+        int64_t x = random_units();
+        int64_t y = random_units();
+        for (bool divide : {false, true}) {
+            if (divide && y == 0) continue;
+            int64_t expected = 0;
+            bool ok = reference_multiply(x, y, divide, expected);
+            bool threw = false;
+            Decimal result;
+            try {
+                result = divide ? Decimal::from_raw(x) / Decimal::from_raw(y) : Decimal::from_raw(x) * Decimal::from_raw(y);
+            } catch (const std::overflow_error&) {
+                threw = true;
+            }
+            CHECK(threw == !ok, x << (divide ? " / " : " * ") << y);
+            if (ok && !threw) {
+                CHECK(result.raw() == expected, x << (divide ? " / " : " * ") << y << " gave " << result.raw());
+            }
+        }
+    }
+}
+#endif
+
+static void test_decimal_arithmetic() {
+    const Decimal min = Decimal::from_raw(std::numeric_limits<int64_t>::min());
+    const Decimal max = Decimal::from_raw(std::numeric_limits<int64_t>::max());
+
+    CHECK((Decimal::parse("0.000001") * Decimal::parse("0.5")).raw() == 1, "0.000001 * 0.5");
+    CHECK((Decimal::parse("-0.000001") * Decimal::parse("0.5")).raw() == -1, "-0.000001 * 0.5");
+    CHECK((Decimal::parse("0.000001") * Decimal::parse("0.499999")).raw() == 0, "0.000001 * 0.499999");
+    CHECK((Decimal::from_int(1) / Decimal::from_int(3)).raw() == 333333, "1 / 3");
+    CHECK((Decimal::from_int(2) / Decimal::from_int(3)).raw() == 666667, "2 / 3");
+    CHECK((Decimal::from_int(-2) / Decimal::from_int(3)).raw() == -666667, "-2 / 3");
+    CHECK(max * Decimal::from_int(1) == max, "max * 1");
+    CHECK(min * Decimal::from_int(1) == min, "min * 1");
+    CHECK(max / Decimal::from_int(1) == max, "max / 1");
+
+    bool overflow = false;
+    try {
+        Decimal::from_int(4000000) * Decimal::from_int(4000000);
+    } catch (const std::overflow_error&) {
+        overflow = true;
+    }
+    CHECK(overflow, "4000000 * 4000000");
+
+    overflow = false;
+    try {
+        min / Decimal::from_int(-1);
+    } catch (const std::overflow_error&) {
+        overflow = true;
+    }
+    CHECK(overflow, "min / -1");
+
+    bool by_zero = false;
+    try {
+        Decimal::from_int(1) / Decimal();
+    } catch (const std::domain_error&) {
+        by_zero = true;
+    }
+    CHECK(by_zero, "1 / 0");
+}
+
+int main() {
+    test_decode_hex();
+    test_uint256();
+    test_url_encode();
+    test_decimal_parse();
+    test_decimal_arithmetic();
+#if defined(__SIZEOF_INT128__)
+    test_wide_arithmetic();
+#endif
+
+#if defined(DOME_FORCE_SCALAR)
+    const char* paths = "scalar";
+#else
+    const char* paths = "SIMD";
+#endif
+    if (failures > 0) {
+        std::cerr << failures << " of " << checks << " checks failed (" << paths << " paths)\n";
+        return 1;
+    }
+    std::cout << checks << " checks passed (" << paths << " paths)\n";
+    return 0;
+}